@@ -1,13 +1,22 @@
 #include <iostream>
+#include <cassert>
 #include <algorithm>
 #include <vector>
 #include <queue>
 #include <list>
+#include <thread>
 
 // Process Modules
 #include "memory.h"
-#include "dram.h"
+#include "memoryModel.h"
+#include "tracer.h"
 #include "crossbar.h"
+#include "network.h"
+#include "frontier.h"
+#include "indirectPrefetcher.h"
+#include "coalescer.h"
+#include "memoryChannels.h"
+#include "functionalEngine.h"
 
 // Pipeline Class
 #include "pipeline.h"
@@ -16,6 +25,10 @@
 // Utility
 #include "option.h"
 #include "edge.h"
+#include "atomicQueue.h"
+#include "radixSort.h"
+#include "clockDomain.h"
+#include "trace.h"
 
 // GraphMat
 #include "bfs.h"
@@ -28,19 +41,37 @@ typedef bool vertex_t;
 // The edge type
 typedef double edge_t;
 
-void print_queue(std::string name, std::list<uint64_t>* q, int iteration) {
-  std::cout << "Iteration: " << iteration << " " << name << " Queue Size " << q->size();
-  std::cout << "   " << name << " Queue: [ ";
-  int i = 0;
-  for(auto it = q->begin(); it != q->end() && i < 20; it++) {
-    std::cout << *it << ", ";
-    i++;
+void print_queue(std::string name, Utility::AtomicQueue<uint64_t>* q, int iteration) {
+  std::cout << "Iteration: " << iteration << " " << name << " Queue Size " << q->size() << "\n" << std::flush;
+}
+
+std::vector<uint64_t> drain_queue(Utility::AtomicQueue<uint64_t>* q) {
+  std::vector<uint64_t> items;
+  items.reserve(q->size());
+  uint64_t item;
+  while(q->pop(item)) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+// Reorder the frontier so that vertices close in memory are processed together
+void order_frontier(Utility::AtomicQueue<uint64_t>* q, Utility::readGraph<vertex_t>& graph, const Utility::Options& opt) {
+  if(opt.frontier_order == "fifo") {
+    return;
   }
-  if(i < 20) {
-    std::cout << "]\n" << std::flush;
+  std::vector<uint64_t> frontier = drain_queue(q);
+  uint64_t threads = opt.host_threads ? opt.host_threads : std::max(1u, std::thread::hardware_concurrency());
+  if(opt.frontier_order == "row") {
+    // Stable, so FIFO order is kept within a row
+    uint64_t row_size = opt.dram_row_size;
+    Utility::radixSort(frontier, [&graph, row_size](uint64_t v) { return (uint64_t)graph.getVertexAddress(v) / row_size; }, threads);
   }
   else {
-    std::cout << "...\n" << std::flush;
+    Utility::radixSort(frontier, [](uint64_t v) { return v; }, threads);
+  }
+  for(auto & element : frontier) {
+    q->push(element);
   }
 }
 
@@ -56,18 +87,81 @@ int main(int argc, char** argv) {
 
   GraphMat::BFS<vertex_t, edge_t> bfs;
 
-  std::list<uint64_t>* process = new std::list<uint64_t>;
+  // Global frontier shared by all pipelines. The apply list can hold the same
+  // vertex more than once, so size for vertices + edges by default.
+  uint64_t frontier_capacity = opt.frontier_capacity;
+  if(frontier_capacity == 0) {
+    frontier_capacity = (uint64_t)graph.getNumNodes() + (uint64_t)graph.getNumNeighbors() + 1;
+  }
+  Utility::AtomicQueue<uint64_t>* process = new Utility::AtomicQueue<uint64_t>(frontier_capacity);
   std::vector<SimObj::Pipeline<vertex_t, edge_t>*>* tile = new std::vector<SimObj::Pipeline<vertex_t, edge_t>*>;
 
-  SimObj::Crossbar<vertex_t, edge_t>* crossbar = new SimObj::Crossbar<vertex_t, edge_t>(opt.num_pipelines);
-#ifdef DRAMSIM2
-  SimObj::Memory* mem = new SimObj::DRAM;
-#else
-  SimObj::Memory* mem = new SimObj::Memory(1,1,1000);
-#endif
+  SimObj::Interconnect<vertex_t, edge_t>* interconnect;
+  if(opt.interconnect == "crossbar") {
+    interconnect = new SimObj::Crossbar<vertex_t, edge_t>(opt.num_pipelines, opt.xbar_depth, opt.xbar_input_depth, opt.xbar_latency,
+      opt.xbar_input_bandwidth, opt.xbar_output_bandwidth, SimObj::arbitration_from_string(opt.xbar_arbitration), opt.xbar_bypass);
+    interconnect->set_name("Crossbar");
+  }
+  else {
+    NoC::Topology topology(NoC::topology_from_string(opt.interconnect), opt.num_pipelines, opt.noc_width);
+    interconnect = new NoC::Network<vertex_t, edge_t>(topology, opt.noc_hop_latency, opt.noc_buffer_depth);
+    interconnect->set_name("Network");
+  }
+  // One memory instance per channel, each behind its own coalescer
+  assert(opt.mem_channels >= 1);
+  std::vector<SimObj::Memory*> mem;
+  std::vector<SimObj::Coalescer*> coalescer;
+  std::vector<SimObj::Memory*> channel_front;
+  for(uint64_t i = 0; i < opt.mem_channels; i++) {
+    mem.push_back(SimObj::new_memory(opt, i));
+    if(opt.coalesce) {
+      coalescer.push_back(new SimObj::Coalescer(mem.back(), opt.dram_data_width));
+      coalescer.back()->set_channel(i);
+      channel_front.push_back(coalescer.back());
+    }
+    else {
+      channel_front.push_back(mem.back());
+    }
+  }
+  Utility::ClockDomain dram_clock(SimObj::dram_clock_khz(opt), opt.pipeline_clock * 1000);
+  SimObj::MemoryChannels* channels = NULL;
+  if(opt.mem_channels > 1) {
+    uint64_t num_pipelines = opt.num_pipelines;
+    channels = new SimObj::MemoryChannels(channel_front, opt.num_pipelines, SimObj::channel_policy_from_string(opt.channel_policy),
+      opt.channel_interleave, opt.remote_latency, opt.remote_bandwidth, opt.dram_data_width,
+      [&graph, num_pipelines](uint64_t addr) {
+        // Vertices are owned by the pipeline the interconnect routes them to
+        int64_t vertex = graph.getVertexAtAddress(addr);
+        return vertex < 0 ? vertex : vertex % (int64_t)num_pipelines;
+      });
+  }
+  // Per-pipeline frontier queues, used for work stealing and vertex splitting
+  SimObj::Frontier* frontier = NULL;
+  if(opt.work_stealing || opt.split_degree) {
+    frontier = new SimObj::Frontier(opt.num_pipelines, opt.work_stealing, opt.steal_latency, opt.steal_batch);
+  }
+
+  // Destination property prefetch buffers, one per interconnect port
+  SimObj::IndirectPrefetcher* indirect = NULL;
+  if(opt.indirect_lookahead) {
+    indirect = new SimObj::IndirectPrefetcher(opt.num_pipelines, opt.indirect_lookahead, opt.indirect_entries, opt.prefetch_hit_latency);
+  }
+
+  // Functional front-end, pipelines only model timing when decoupled
+  SimObj::FunctionalEngine<vertex_t, edge_t>* engine = NULL;
+  if(opt.decoupled) {
+    engine = new SimObj::FunctionalEngine<vertex_t, edge_t>(opt.num_pipelines, opt.decoupled_depth, &graph, &bfs);
+  }
+
+  // Trace of every request the pipelines send toward DRAM, see tools/replay.cpp
+  Utility::TraceWriter* trace = NULL;
+  if(!opt.trace.empty()) {
+    trace = new Utility::TraceWriter(opt.trace);
+    trace->set_channels(opt.mem_channels);
+  }
 
   for(uint64_t i = 0; i < opt.num_pipelines; i++) {
-    SimObj::Pipeline<vertex_t, edge_t>* temp = new SimObj::Pipeline<vertex_t, edge_t>(i, opt, &graph, process, &bfs, mem, crossbar);
+    SimObj::Pipeline<vertex_t, edge_t>* temp = new SimObj::Pipeline<vertex_t, edge_t>(i, opt, &graph, process, &bfs, channels ? channels->get_port(i) : channel_front[0], interconnect, frontier, indirect, trace, engine);
     tile->push_back(temp);
   }
 
@@ -78,35 +172,73 @@ int main(int argc, char** argv) {
   uint64_t apply_size = 0;
 
   // Setup problem:
-  process->push_back(1);
+  process->push(1);
   graph.setVertexProperty(1, true);
 
   // Iteration Loop:
-  for(uint64_t iteration = 0; iteration < opt.num_iter && !process->empty(); iteration++) {
+  for(uint64_t iteration = 0; iteration < opt.num_iter && !process->isEmpty(); iteration++) {
     // Reset all the stats Counters:
     SimObj::sim_out.write("---------------------------------------------------------------\n");
     SimObj::sim_out.write("ITERATION " + std::to_string(iteration) + "\n");
     SimObj::sim_out.write("---------------------------------------------------------------\n");
     std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->clear_stats();});
-    crossbar->clear_stats();
+    interconnect->clear_stats();
+    std::for_each(mem.begin(), mem.end(), [](SimObj::Memory* a) {a->clear_stats();});
+    if(frontier) frontier->clear_stats();
+    if(indirect) indirect->clear_stats();
+    std::for_each(coalescer.begin(), coalescer.end(), [](SimObj::Coalescer* a) {a->clear_stats();});
+    if(channels) channels->clear_stats();
+    if(engine) engine->clear_stats();
 
 #ifdef DEBUG
     print_queue("Process", process, iteration);
     //graph.printVertexProperties();
 #endif
-    // Processing Phase 
-    std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->process_ready();});
-    complete = false;
-    while(!complete || (process->size() != 0)) {
-      global_tick++;
-      std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->tick_process();});
-      //std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->print_debug();});
-      crossbar->tick();
-      mem->tick();
-      complete = true;
-      std::for_each(tile->begin(), tile->end(), [&complete, crossbar](SimObj::Pipeline<vertex_t, edge_t>* a) mutable {
-        if(!a->process_complete() || crossbar->busy()) complete = false;
-      });
+    // Processing Phase, one pass over the frontier per destination slice
+    order_frontier(process, graph, opt);
+    std::vector<uint64_t> active;
+    if(graph.getNumSlices() > 1 || engine) {
+      active = drain_queue(process);
+    }
+    uint64_t source_reads = 0;
+    for(int slice = 0; slice < graph.getNumSlices(); slice++) {
+      graph.setSlice(slice);
+      if(engine) {
+        // Vertices are handed out round-robin by the functional engine
+        engine->start(active);
+        source_reads += active.size();
+      }
+      else if(graph.getNumSlices() > 1) {
+        for(auto & vertex : active) {
+          process->push(vertex);
+        }
+        source_reads += active.size();
+      }
+      if(frontier) {
+        frontier->distribute(process,
+          [&graph](uint64_t v) { return (uint64_t)graph.getNumChunks(v); },
+          [&graph](uint64_t v, uint64_t c) { return (uint64_t)graph.getChunkStart(v, c); });
+      }
+      std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->process_ready();});
+      complete = false;
+      while(!complete || (process->size() != 0) || (frontier && !frontier->empty())) {
+        global_tick++;
+        if(trace) trace->tick();
+        std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->tick_process();});
+        //std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->print_debug();});
+        interconnect->tick();
+        if(indirect) indirect->tick();
+        for(uint64_t i = dram_clock.advance(); i > 0; i--) {
+          std::for_each(mem.begin(), mem.end(), [](SimObj::Memory* a) {a->tick();});
+        }
+        std::for_each(coalescer.begin(), coalescer.end(), [](SimObj::Coalescer* a) {a->tick();});
+        if(channels) channels->tick();
+        complete = true;
+        std::for_each(tile->begin(), tile->end(), [&complete, interconnect](SimObj::Pipeline<vertex_t, edge_t>* a) mutable {
+          if(!a->process_complete() || interconnect->busy()) complete = false;
+        });
+      }
+      if(engine) engine->join();
     }
 #ifdef DEBUG
     //print_queue("Apply", apply, iteration);
@@ -125,9 +257,14 @@ int main(int argc, char** argv) {
     complete = false;
     while(!complete || (apply_size != 0)) {
       global_tick++;
+      if(trace) trace->tick();
       std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->tick_apply();});
       //std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->print_debug();});
-      mem->tick();
+      for(uint64_t i = dram_clock.advance(); i > 0; i--) {
+        std::for_each(mem.begin(), mem.end(), [](SimObj::Memory* a) {a->tick();});
+      }
+      std::for_each(coalescer.begin(), coalescer.end(), [](SimObj::Coalescer* a) {a->tick();});
+      if(channels) channels->tick();
       complete = true;
       std::for_each(tile->begin(), tile->end(), [&complete](SimObj::Pipeline<vertex_t, edge_t>* a) mutable {
         if(!a->apply_complete()) complete = false;
@@ -140,18 +277,34 @@ int main(int argc, char** argv) {
 
     // Print all the stats counters:
     std::for_each(tile->begin(), tile->end(), [](SimObj::Pipeline<vertex_t, edge_t>* a) {a->print_stats_csv();});
-    crossbar->print_stats_csv();
+    interconnect->print_stats_csv();
+    std::for_each(mem.begin(), mem.end(), [](SimObj::Memory* a) {a->print_stats_csv();});
+    if(frontier) frontier->print_stats_csv();
+    if(indirect) indirect->print_stats_csv();
+    std::for_each(coalescer.begin(), coalescer.end(), [](SimObj::Coalescer* a) {a->print_stats_csv();});
+    if(channels) channels->print_stats_csv();
+    if(engine) engine->print_stats_csv();
+    if(graph.getNumSlices() > 1) {
+      // Every slice after the first reads the source properties again
+      SimObj::sim_out.write("Slicing,slices," + std::to_string(graph.getNumSlices()) +
+                            ",source_reads," + std::to_string(source_reads) +
+                            ",extra_source_reads," + std::to_string(source_reads - active.size()) + "\n");
+    }
   }
 #ifdef DEBUG
   graph.printVertexProperties(30);
   std::cout << "Global Ticks, " << global_tick << ", Edges Processed, " << edges_processed << ", Throughput (Edges/Cycle), " << (float)edges_processed/(float)global_tick << "\n";
 #endif
 
-  mem->print_stats();
+  std::for_each(mem.begin(), mem.end(), [](SimObj::Memory* a) {a->print_stats();});
 
   for(uint64_t i = 0; i < opt.num_pipelines; i++) {
     delete tile->operator[](i);
   }
+  if(trace) {
+    std::cout << "Trace: " << trace->get_records() << " requests written to " << opt.trace << "\n";
+    delete trace;
+  }
 
   graph.writeVertexPropertyToFile(opt.result);
 
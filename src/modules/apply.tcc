@@ -39,7 +39,7 @@ SimObj::Apply<v_t, e_t>::~Apply() {
 template<class v_t, class e_t>
 void SimObj::Apply<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
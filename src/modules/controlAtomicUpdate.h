@@ -5,6 +5,10 @@
  *  The control atomic update module is part of the atomic update sequence of the
  *  graphicionado pipeline.
  *
+ *  Destinations of the edges between here and WriteTempDstProperty are held
+ *  in a CAM. An edge to a destination already in flight would read a stale
+ *  temp property, so it waits (STALL_ATOMIC) until that edge is written.
+ *
  */
 
 #ifndef CONTROLATOMICUPDATE_H
@@ -14,10 +18,10 @@
 #include <vector>
 #include <cstdint>
 #include <map>
-#include <list>
 
 #include "module.h"
 #include "memory.h"
+#include "cam.h"
 
 #include "readGraph.h"
 
@@ -49,16 +53,26 @@ private:
 
   op_t _state;
   bool _op_complete;
-  std::list<Utility::pipeline_data<v_t, e_t>> _nodes;
+  Utility::Cam* _in_flight; // Destination vertex ids
+
+  // Send _data on if its destination is free, sets _stall
+  bool issue(void);
 
-  bool dependency();
+  // Stats
+  using Module<v_t, e_t>::_stall_ticks;
+  using Module<v_t, e_t>::_items_processed;
+  uint64_t _conflicts; // Edges that found their destination in flight
 
 public:
   ControlAtomicUpdate();
+  ControlAtomicUpdate(uint64_t max_in_flight);
   ~ControlAtomicUpdate();
 
   void tick(void);
-  Utility::pipeline_data<v_t, e_t> signal();
+  // An edge to vertex_dst_id has been written
+  void signal(uint64_t vertex_dst_id);
+  void print_stats_csv(void);
+  void clear_stats(void);
   void debug(void);
 };
 
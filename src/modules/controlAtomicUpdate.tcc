@@ -10,33 +10,46 @@
 #include <cassert>
 
 template<class v_t, class e_t>
-SimObj::ControlAtomicUpdate<v_t, e_t>::ControlAtomicUpdate() {
+SimObj::ControlAtomicUpdate<v_t, e_t>::ControlAtomicUpdate() : ControlAtomicUpdate(1) {
+}
+
+template<class v_t, class e_t>
+SimObj::ControlAtomicUpdate<v_t, e_t>::ControlAtomicUpdate(uint64_t max_in_flight) {
+  assert(max_in_flight > 0);
   _state = OP_WAIT;
   _ready = false;
   _op_complete = false;
+  _in_flight = new Utility::Cam(max_in_flight);
+  _conflicts = 0;
 }
 
 template<class v_t, class e_t>
 SimObj::ControlAtomicUpdate<v_t, e_t>::~ControlAtomicUpdate() {
-  // Do nothing
+  delete _in_flight;
+  _in_flight = NULL;
 }
 
 template<class v_t, class e_t>
-bool SimObj::ControlAtomicUpdate<v_t, e_t>::dependency() {
-  bool ret = false;
-  for(auto it = _nodes.begin(); it != _nodes.end(); it++) {
-    if(_data.edge_id == it->edge_id) {
-      ret = true;
-      break;
-    }
+bool SimObj::ControlAtomicUpdate<v_t, e_t>::issue(void) {
+  if(_in_flight->contains(_data.vertex_dst_id)) {
+    _stall = STALL_ATOMIC;
+    return false;
   }
-  return ret;
+  if(_in_flight->full() || _next->is_stalled() != STALL_CAN_ACCEPT) {
+    _stall = STALL_PIPE;
+    return false;
+  }
+  _next->ready(_data);
+  _in_flight->insert(_data.vertex_dst_id);
+  _stall = STALL_CAN_ACCEPT;
+  _has_work = false;
+  return true;
 }
 
 template<class v_t, class e_t>
 void SimObj::ControlAtomicUpdate<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -46,16 +59,14 @@ void SimObj::ControlAtomicUpdate<v_t, e_t>::tick(void) {
         std::cout << "Tick:" << _tick << " " << _name << " recieved: " << _data << "\n";
 #endif
         _ready = false;
-        if(!dependency() && _next->is_stalled() == STALL_CAN_ACCEPT) {
-          _next->ready(_data);
-          _nodes.push_front(_data);
+        if(issue()) {
           next_state = OP_WAIT;
-          _stall = STALL_CAN_ACCEPT;
-          _has_work = false;
         }
         else {
+          if(_stall == STALL_ATOMIC) {
+            _conflicts++;
+          }
           next_state = OP_STALL;
-          _stall = STALL_PIPE;
         }
       }
       else {
@@ -65,24 +76,9 @@ void SimObj::ControlAtomicUpdate<v_t, e_t>::tick(void) {
       }
       break;
     }
-    // If there is a dep stall the pipe until the edge completes
+    // Hold the edge until its destination is written and the pipe has room
     case OP_STALL : {
-      // Check if an edge was finalized:
-      //std::cout << "Dependency: " << dependency() << " Queue Size: " << _nodes.size() << "\n";
-      if(!dependency() && _next->is_stalled() == STALL_CAN_ACCEPT) {
-        _next->ready(_data);
-        _nodes.push_front(_data);
-#ifdef DEBUG
-          assert(_nodes.size() < 4);
-#endif
-        next_state = OP_WAIT;
-        _stall = STALL_CAN_ACCEPT;
-        _has_work = false;
-      }
-      else {
-        next_state = OP_STALL;
-        _stall = STALL_PIPE;
-      }
+      next_state = issue() ? OP_WAIT : OP_STALL;
       break;
     }
     default : {
@@ -99,18 +95,30 @@ void SimObj::ControlAtomicUpdate<v_t, e_t>::tick(void) {
 }
 
 template<class v_t, class e_t>
-Utility::pipeline_data<v_t, e_t> SimObj::ControlAtomicUpdate<v_t, e_t>::signal(void) {
-  Utility::pipeline_data<v_t, e_t> ret = _nodes.back();
-  _nodes.pop_back();
-  return ret;
+void SimObj::ControlAtomicUpdate<v_t, e_t>::signal(uint64_t vertex_dst_id) {
+  // The next edge to this destination may go
+  _in_flight->erase(vertex_dst_id);
 }
 
+template<class v_t, class e_t>
+void SimObj::ControlAtomicUpdate<v_t, e_t>::print_stats_csv(void) {
+  sim_out.write(_name + ","
+    + std::to_string(_stall_ticks[STALL_CAN_ACCEPT]) + ","
+    + std::to_string(_stall_ticks[STALL_PROCESSING]) + ","
+    + std::to_string(_stall_ticks[STALL_PIPE]) + ","
+    + std::to_string(_stall_ticks[STALL_MEM]) + ","
+    + std::to_string(_items_processed) + ","
+    + std::to_string(_stall_ticks[STALL_ATOMIC]) + ","
+    + std::to_string(_conflicts) + "\n");
+}
+
+template<class v_t, class e_t>
+void SimObj::ControlAtomicUpdate<v_t, e_t>::clear_stats(void) {
+  Module<v_t, e_t>::clear_stats();
+  _conflicts = 0;
+}
 
 template<class v_t, class e_t>
 void SimObj::ControlAtomicUpdate<v_t, e_t>::debug(void) {
-  std::cout << "[";
-  for(auto it = _nodes.begin(); it != _nodes.end(); it++) {
-    std::cout << *it << ",";
-  }
-  std::cout << "]\n";
+  std::cout << "[ " << _name << " ] " << _in_flight->size() << "/" << _in_flight->depth() << " destinations in flight\n";
 }
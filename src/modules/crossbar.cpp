@@ -0,0 +1,20 @@
+/*
+ * Andrew Smith
+ *
+ * Crossbar Pipeline Module
+ *
+ */
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "crossbar.h"
+
+SimObj::arbitration_t SimObj::arbitration_from_string(const std::string& name) {
+  if(name == "rr") return ARB_ROUND_ROBIN;
+  if(name == "age") return ARB_AGE;
+  std::cerr << "[ Crossbar ] unknown arbitration policy: " << name << "\n";
+  assert(false);
+  return ARB_ROUND_ROBIN;
+}
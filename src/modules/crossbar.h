@@ -2,6 +2,19 @@
  * Andrew Smith
  *
  * Crossbar Pipeline Module
+ *  Routes each edge to the pipeline owning its destination. Every output
+ *  port has a queue of depth items in front of its ReadDstProperty stage.
+ *
+ *  Without input queues the sending stages write straight into the output
+ *  queues, first come first served in pipeline order. With input queues an
+ *  allocator moves input queue heads to the outputs each cycle, picking
+ *  between inputs round-robin or oldest first, limited by the input and
+ *  output bandwidth. Items take latency cycles to cross the switch, unless
+ *  bypass is set and they stay in the pipeline they came from.
+ *
+ *  The output bandwidth only limits how many items enter an output queue
+ *  per cycle. Each queue hands at most one item per cycle to its stage,
+ *  which takes one item at a time.
  *
  */
 
@@ -9,44 +22,76 @@
 #define CROSSBAR_H
 
 #include <iostream>
+#include <string>
 #include <vector>
-#include <queue>
 
-#include "module.h"
+#include "interconnect.h"
+#include "ringBuffer.h"
 
 namespace SimObj {
 
+enum arbitration_t {
+  ARB_ROUND_ROBIN,
+  ARB_AGE,
+  ARB_NUM_TYPES
+};
+
+arbitration_t arbitration_from_string(const std::string& name);
+
 template<class v_t, class e_t>
-class Crossbar : public Module<v_t, e_t> {
+class Crossbar : public Interconnect<v_t, e_t> {
 private:
+  struct entry_t {
+    Utility::pipeline_data<v_t, e_t> data;
+    uint64_t arrival;  // Tick the item entered the crossbar
+    uint64_t ready_at; // Tick the item may leave its output queue
+  };
+
+  using Module<v_t, e_t>::_tick;
+  using Interconnect<v_t, e_t>::_num_ports;
+  using Interconnect<v_t, e_t>::_out_module;
+  using Interconnect<v_t, e_t>::route;
+
   uint64_t _max_queue_size;
-  uint64_t _num_ports;
-  std::vector<std::queue<Utility::pipeline_data<v_t, e_t>>> _msg_queue;
-  std::vector<Module<v_t, e_t>*> _in_module;
-  std::vector<Module<v_t, e_t>*> _out_module;
-  
-  uint64_t route(Utility::pipeline_data<v_t, e_t> vertex) {
-    return vertex.vertex_dst_id % _num_ports;
+  uint64_t _input_depth; // 0: no input queues
+  uint64_t _latency;
+  uint64_t _input_bandwidth;
+  uint64_t _output_bandwidth;
+  arbitration_t _arbitration;
+  bool _bypass;
+  std::vector<Utility::RingBuffer<entry_t>*> _msg_queue;
+  std::vector<Utility::RingBuffer<entry_t>*> _input_queue;
+  std::vector<uint64_t> _rr_next; // Round-robin pointer per output
+  std::vector<uint64_t> _input_sent; // Switch traversals this cycle
+  std::vector<uint64_t> _output_received;
+  std::vector<bool> _input_lost; // Lost an arbitration this cycle
+
+  bool local(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data) {
+    return _bypass && route(data) == port;
   }
 
+  bool switch_free(uint64_t in, uint64_t out);
+  void traverse(uint64_t in, const entry_t& entry);
+  void allocate(void);
+
   // Stats
   using Module<v_t, e_t>::_items_processed;
   using Module<v_t, e_t>::_name;
   std::vector<uint64_t> _input_items;
   std::vector<uint64_t> _output_items;
-  
-public:
-
-
+  uint64_t _cycles;
+  uint64_t _conflicts;    // Inputs that lost an arbitration, once per cycle
+  uint64_t _hol_blocking; // Cycles an input head blocked an item that could go
+  uint64_t _bypassed;
 
+public:
   Crossbar(uint64_t num_ports);
+  Crossbar(uint64_t num_ports, uint64_t depth, uint64_t input_depth, uint64_t latency, uint64_t input_bandwidth,
+           uint64_t output_bandwidth, arbitration_t arbitration, bool bypass);
   ~Crossbar();
 
-  void connect_input(Module<v_t, e_t>* in_module, uint64_t port_num);
-  void connect_output(Module<v_t, e_t>* out_module, uint64_t port_num);
-
-  stall_t is_stalled(Utility::pipeline_data<v_t, e_t> data);
-  void ready(Utility::pipeline_data<v_t, e_t> data);
+  stall_t is_stalled(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data);
+  void ready(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data);
   bool busy();
   void clear_stats();
   void print_stats();
@@ -5,71 +5,197 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
 
 template<class v_t, class e_t>
-SimObj::Crossbar<v_t, e_t>::Crossbar(uint64_t num_ports) {
-  assert(num_ports > 0);
-  _max_queue_size = 1;
-  _num_ports = num_ports;
+SimObj::Crossbar<v_t, e_t>::Crossbar(uint64_t num_ports) : Crossbar(num_ports, 1, 0, 0, 1, 1, ARB_ROUND_ROBIN, false) {
+}
+
+template<class v_t, class e_t>
+SimObj::Crossbar<v_t, e_t>::Crossbar(uint64_t num_ports, uint64_t depth, uint64_t input_depth, uint64_t latency, uint64_t input_bandwidth,
+                                     uint64_t output_bandwidth, arbitration_t arbitration, bool bypass) : Interconnect<v_t, e_t>(num_ports) {
+  assert(depth > 0);
+  assert(input_bandwidth > 0);
+  assert(output_bandwidth > 0);
+  _max_queue_size = depth;
+  _input_depth = input_depth;
+  _latency = latency;
+  _input_bandwidth = input_bandwidth;
+  _output_bandwidth = output_bandwidth;
+  _arbitration = arbitration;
+  _bypass = bypass;
   _msg_queue.resize(num_ports);
-  _in_module.resize(num_ports);
-  _out_module.resize(num_ports);
+  for(auto & queue : _msg_queue) {
+    queue = new Utility::RingBuffer<entry_t>(_max_queue_size);
+  }
+  if(_input_depth != 0) {
+    _input_queue.resize(num_ports);
+    for(auto & queue : _input_queue) {
+      queue = new Utility::RingBuffer<entry_t>(_input_depth);
+    }
+  }
+  _rr_next.resize(num_ports, 0);
+  _input_sent.resize(num_ports, 0);
+  _output_received.resize(num_ports, 0);
+  _input_lost.resize(num_ports, false);
   _input_items.resize(num_ports);
   _output_items.resize(num_ports);
+  _cycles = 0;
+  _conflicts = 0;
+  _hol_blocking = 0;
+  _bypassed = 0;
 }
 
 template<class v_t, class e_t>
 SimObj::Crossbar<v_t, e_t>::~Crossbar() {
-  // Do Nothing
+  for(auto & queue : _msg_queue) {
+    delete queue;
+    queue = NULL;
+  }
+  for(auto & queue : _input_queue) {
+    delete queue;
+    queue = NULL;
+  }
 }
 
 template<class v_t, class e_t>
-void SimObj::Crossbar<v_t, e_t>::connect_input(Module<v_t, e_t>* in_module, uint64_t port_num) {
-  assert(port_num < _num_ports);
-  assert(in_module != NULL);
-  _in_module[port_num] = in_module;
+bool SimObj::Crossbar<v_t, e_t>::switch_free(uint64_t in, uint64_t out) {
+  return !_msg_queue[out]->full() && _input_sent[in] < _input_bandwidth && _output_received[out] < _output_bandwidth;
 }
 
 template<class v_t, class e_t>
-void SimObj::Crossbar<v_t, e_t>::connect_output(Module<v_t, e_t>* out_module, uint64_t port_num) {
-  assert(port_num < _num_ports);
-  assert(out_module != NULL);
-  _out_module[port_num] = out_module;
+void SimObj::Crossbar<v_t, e_t>::traverse(uint64_t in, const entry_t& entry) {
+  uint64_t out = route(entry.data);
+  _input_sent[in]++;
+  _output_received[out]++;
+  _output_items[out]++;
+  _msg_queue[out]->push(entry);
 }
 
 template<class v_t, class e_t>
-void SimObj::Crossbar<v_t, e_t>::ready(Utility::pipeline_data<v_t, e_t> data) {
-  _msg_queue[route(data)].push(data);
-  _output_items[route(data)]++;
+void SimObj::Crossbar<v_t, e_t>::ready(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data) {
+  assert(is_stalled(port, data) == STALL_CAN_ACCEPT);
+  _input_items[port]++;
+  entry_t entry;
+  entry.data = data;
+  // Sent during the cycle the crossbar ticks next
+  entry.arrival = _tick + 1;
+  entry.ready_at = _tick + 1;
+  if(local(port, data)) {
+    _msg_queue[port]->push(entry);
+    _output_items[port]++;
+    _bypassed++;
+  }
+  else if(_input_depth == 0) {
+    entry.ready_at += _latency;
+    traverse(port, entry);
+  }
+  else {
+    _input_queue[port]->push(entry);
+  }
 }
 
 template<class v_t, class e_t>
-SimObj::stall_t SimObj::Crossbar<v_t, e_t>::is_stalled(Utility::pipeline_data<v_t, e_t> data) {
-  if(_msg_queue[route(data)].size() < _max_queue_size) {
-    return STALL_CAN_ACCEPT;
+SimObj::stall_t SimObj::Crossbar<v_t, e_t>::is_stalled(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data) {
+  bool full;
+  if(local(port, data)) {
+    full = _msg_queue[port]->full();
+  }
+  else if(_input_depth == 0) {
+    full = !switch_free(port, route(data));
+  }
+  else {
+    full = _input_queue[port]->full();
+  }
+  return full ? STALL_PIPE : STALL_CAN_ACCEPT;
+}
+
+template<class v_t, class e_t>
+void SimObj::Crossbar<v_t, e_t>::allocate(void) {
+  std::fill(_input_lost.begin(), _input_lost.end(), false);
+  // Grant one input per output per pass until nothing else can cross
+  bool granted = true;
+  while(granted) {
+    granted = false;
+    for(uint64_t out = 0; out < _num_ports; out++) {
+      uint64_t winner = _num_ports;
+      for(uint64_t i = 0; i < _num_ports; i++) {
+        uint64_t in = (_rr_next[out] + i) % _num_ports;
+        if(_input_queue[in]->empty() || route(_input_queue[in]->front().data) != out || !switch_free(in, out)) {
+          continue;
+        }
+        if(winner == _num_ports ||
+           (_arbitration == ARB_AGE && _input_queue[in]->front().arrival < _input_queue[winner]->front().arrival)) {
+          winner = in;
+        }
+      }
+      if(winner == _num_ports) {
+        continue;
+      }
+      // The other candidates lost, an input counts once per cycle
+      for(uint64_t in = 0; in < _num_ports; in++) {
+        if(in != winner && !_input_queue[in]->empty() && route(_input_queue[in]->front().data) == out && switch_free(in, out)) {
+          _input_lost[in] = true;
+        }
+      }
+      entry_t entry = _input_queue[winner]->front();
+      _input_queue[winner]->pop();
+      entry.ready_at = _tick + _latency;
+      traverse(winner, entry);
+      _rr_next[out] = (winner + 1) % _num_ports;
+      granted = true;
+    }
+  }
+
+  _conflicts += std::count(_input_lost.begin(), _input_lost.end(), true);
+
+  // A blocked head holding back an item whose output had room
+  for(uint64_t in = 0; in < _num_ports; in++) {
+    Utility::RingBuffer<entry_t>* queue = _input_queue[in];
+    if(queue->empty() || _input_sent[in] >= _input_bandwidth) {
+      continue;
+    }
+    for(uint64_t i = 1; i < queue->size(); i++) {
+      if(switch_free(in, route(queue->at(i).data))) {
+        _hol_blocking++;
+        break;
+      }
+    }
   }
-  return STALL_PIPE;
 }
 
 template<class v_t, class e_t>
 void SimObj::Crossbar<v_t, e_t>::tick() {
+  _tick++;
+  _cycles++;
+  if(_input_depth != 0) {
+    allocate();
+  }
   /* Loop over message Queues, signal a module as ready if the queue !empty and
    * the corresponding pipeline stage can accept data. */
   for(uint64_t pipeline_id = 0; pipeline_id < _msg_queue.size(); pipeline_id++) {
-    if(_out_module[pipeline_id]->is_stalled() == STALL_CAN_ACCEPT && !_msg_queue[pipeline_id].empty()) {
-      Utility::pipeline_data<v_t, e_t> ret = _msg_queue[pipeline_id].front();
-      _msg_queue[pipeline_id].pop();
-      //std::cout << "Queue[" << pipeline_id << "] Size = " << _msg_queue[pipeline_id].size() << "\n";
-      _out_module[pipeline_id]->ready(ret);
+    if(_out_module[pipeline_id]->is_stalled() == STALL_CAN_ACCEPT && !_msg_queue[pipeline_id]->empty() &&
+       _msg_queue[pipeline_id]->front().ready_at <= _tick) {
+      // Hand the head over by reference before popping it, no temporary copy
+      _out_module[pipeline_id]->ready(_msg_queue[pipeline_id]->front().data);
+      _msg_queue[pipeline_id]->pop();
+      _items_processed++;
     }
   }
+  std::fill(_input_sent.begin(), _input_sent.end(), 0);
+  std::fill(_output_received.begin(), _output_received.end(), 0);
 }
 
 template<class v_t, class e_t>
 bool SimObj::Crossbar<v_t, e_t>::busy() {
   for(auto it = _msg_queue.begin(); it != _msg_queue.end(); it++) {
-    if(!it->empty()) {
+    if(!(*it)->empty()) {
+      return true;
+    }
+  }
+  for(auto it = _input_queue.begin(); it != _input_queue.end(); it++) {
+    if(!(*it)->empty()) {
       return true;
     }
   }
@@ -85,6 +211,10 @@ void SimObj::Crossbar<v_t, e_t>::clear_stats() {
     element = 0;
   }
   _items_processed = 0;
+  _cycles = 0;
+  _conflicts = 0;
+  _hol_blocking = 0;
+  _bypassed = 0;
 }
 
 template<class v_t, class e_t>
@@ -105,6 +235,9 @@ void SimObj::Crossbar<v_t, e_t>::print_stats() {
   sim_out.write("\n");
   sim_out.write("  Performance:\n");
   sim_out.write("    Items Processed:  " + std::to_string(_items_processed) + "\n");
+  sim_out.write("    Conflicts:        " + std::to_string(_conflicts) + "\n");
+  sim_out.write("    HOL Blocking:     " + std::to_string(_hol_blocking) + " cycles\n");
+  sim_out.write("    Bypassed:         " + std::to_string(_bypassed) + "\n");
 }
 
 template<class v_t, class e_t>
@@ -118,5 +251,17 @@ void SimObj::Crossbar<v_t, e_t>::print_stats_csv() {
   for(auto & element : _output_items) {
     sim_out.write(std::to_string(element) + ",");
   }
-  sim_out.write("performance," + std::to_string(_items_processed) + "\n");
+  sim_out.write("performance," + std::to_string(_items_processed));
+  // Items per cycle on each port's link into and out of the switch
+  sim_out.write(",input_utilization,");
+  for(auto & element : _input_items) {
+    sim_out.write(std::to_string(_cycles ? (double)element / (double)_cycles : 0.0) + ",");
+  }
+  sim_out.write("output_utilization,");
+  for(auto & element : _output_items) {
+    sim_out.write(std::to_string(_cycles ? (double)element / (double)_cycles : 0.0) + ",");
+  }
+  sim_out.write("conflicts," + std::to_string(_conflicts) +
+                ",hol_blocking," + std::to_string(_hol_blocking) +
+                ",bypassed," + std::to_string(_bypassed) + "\n");
 }
@@ -0,0 +1,56 @@
+/*
+ * Andrew Smith
+ *
+ * FIFO:
+ *  Decoupling buffer between two adjacent pipeline stages. Accepts an item
+ *  whenever it has room and forwards the oldest one as soon as the next
+ *  stage can accept it. Ticked right after the upstream stage, so an empty
+ *  FIFO adds no latency. Keeps a histogram of its occupancy per cycle.
+ *
+ */
+
+#ifndef FIFO_H
+#define FIFO_H
+
+#include <cstdint>
+#include <vector>
+
+#include "module.h"
+#include "ringBuffer.h"
+
+namespace SimObj {
+
+template<class v_t, class e_t>
+class Fifo : public Module<v_t, e_t> {
+private:
+  using Module<v_t, e_t>::_tick;
+  using Module<v_t, e_t>::_stall;
+  using Module<v_t, e_t>::_next;
+  using Module<v_t, e_t>::_name;
+  using Module<v_t, e_t>::_has_work;
+  using Module<v_t, e_t>::_items_processed;
+
+  Utility::RingBuffer<Utility::pipeline_data<v_t, e_t>>* _queue;
+
+  // Stats
+  std::vector<uint64_t> _occupancy; // Cycles spent holding i items
+
+public:
+  Fifo();
+  Fifo(uint64_t depth);
+  ~Fifo();
+
+  void tick(void);
+  stall_t is_stalled(void);
+  stall_t is_stalled(const Utility::pipeline_data<v_t, e_t>& data);
+  void ready(const Utility::pipeline_data<v_t, e_t>& data);
+  void print_stats(void);
+  void print_stats_csv(void);
+  void clear_stats(void);
+};
+
+} // namespace SimObj
+
+#include "fifo.tcc"
+
+#endif
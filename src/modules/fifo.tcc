@@ -0,0 +1,95 @@
+/*
+ * Andrew Smith
+ *
+ * FIFO:
+ *  Decoupling buffer between two adjacent pipeline stages.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+
+template<class v_t, class e_t>
+SimObj::Fifo<v_t, e_t>::Fifo() : Fifo(1) {
+}
+
+template<class v_t, class e_t>
+SimObj::Fifo<v_t, e_t>::Fifo(uint64_t depth) {
+  assert(depth > 0);
+  _queue = new Utility::RingBuffer<Utility::pipeline_data<v_t, e_t>>(depth);
+  _occupancy.resize(depth + 1, 0);
+  _items_processed = 0;
+}
+
+template<class v_t, class e_t>
+SimObj::Fifo<v_t, e_t>::~Fifo() {
+  delete _queue;
+  _queue = NULL;
+}
+
+template<class v_t, class e_t>
+void SimObj::Fifo<v_t, e_t>::tick(void) {
+  _tick++;
+  if(!_queue->empty() && _next->is_stalled(_queue->front()) == STALL_CAN_ACCEPT) {
+    _next->ready(_queue->front());
+    _queue->pop();
+  }
+  _occupancy[_queue->size()]++;
+  _stall = _queue->full() ? STALL_PIPE : STALL_CAN_ACCEPT;
+  _has_work = !_queue->empty();
+  this->update_stats();
+}
+
+template<class v_t, class e_t>
+SimObj::stall_t SimObj::Fifo<v_t, e_t>::is_stalled(void) {
+  return _queue->full() ? STALL_PIPE : STALL_CAN_ACCEPT;
+}
+
+template<class v_t, class e_t>
+SimObj::stall_t SimObj::Fifo<v_t, e_t>::is_stalled(const Utility::pipeline_data<v_t, e_t>& data) {
+  return is_stalled();
+}
+
+template<class v_t, class e_t>
+void SimObj::Fifo<v_t, e_t>::ready(const Utility::pipeline_data<v_t, e_t>& data) {
+  // Upstream only sends after seeing room
+  assert(!_queue->full());
+  _queue->push(data);
+  _has_work = true;
+  _items_processed++;
+}
+
+template<class v_t, class e_t>
+void SimObj::Fifo<v_t, e_t>::print_stats(void) {
+  Module<v_t, e_t>::print_stats();
+  sim_out.write("  Occupancy (cycles holding 0.." + std::to_string(_queue->capacity()) + " items):\n    ");
+  for(auto & element : _occupancy) {
+    sim_out.write(std::to_string(element) + ", ");
+  }
+  sim_out.write("\n");
+}
+
+template<class v_t, class e_t>
+void SimObj::Fifo<v_t, e_t>::print_stats_csv(void) {
+  uint64_t cycles = 0;
+  uint64_t weighted = 0;
+  for(uint64_t i = 0; i < _occupancy.size(); i++) {
+    cycles += _occupancy[i];
+    weighted += i * _occupancy[i];
+  }
+  sim_out.write(_name + ",depth," + std::to_string(_queue->capacity()) +
+                ",items," + std::to_string(_items_processed) +
+                ",full_cycles," + std::to_string(_occupancy.back()) +
+                ",avg_occupancy," + std::to_string(cycles ? (double)weighted / (double)cycles : 0.0) +
+                ",occupancy");
+  for(auto & element : _occupancy) {
+    sim_out.write("," + std::to_string(element));
+  }
+  sim_out.write("\n");
+}
+
+template<class v_t, class e_t>
+void SimObj::Fifo<v_t, e_t>::clear_stats(void) {
+  Module<v_t, e_t>::clear_stats();
+  std::fill(_occupancy.begin(), _occupancy.end(), 0);
+}
@@ -0,0 +1,188 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Frontier:
+ *  Per-pipeline active vertex queues with work stealing.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "frontier.h"
+#include "log.h"
+
+SimObj::Frontier::Frontier(uint64_t num_pipelines, bool stealing, uint64_t steal_latency, uint64_t steal_batch) {
+  assert(num_pipelines > 0);
+  assert(steal_batch > 0);
+  _num_pipelines = num_pipelines;
+  _stealing = stealing;
+  _steal_latency = steal_latency;
+  _steal_batch = steal_batch;
+  _queues.resize(num_pipelines);
+  _distributed.resize(num_pipelines, 0);
+  _taken.resize(num_pipelines, 0);
+  _steals.resize(num_pipelines, 0);
+  _stolen.resize(num_pipelines, 0);
+  _failed_steals.resize(num_pipelines, 0);
+  _split_vertices = 0;
+  _split_chunks = 0;
+}
+
+SimObj::Frontier::~Frontier() {
+  // Do Nothing
+}
+
+void SimObj::Frontier::push(uint64_t pipeline_id, uint64_t vertex_id, uint64_t edge_start) {
+  assert(pipeline_id < _num_pipelines);
+  _queues[pipeline_id].push_back({vertex_id, edge_start});
+  _distributed[pipeline_id]++;
+}
+
+bool SimObj::Frontier::pop(uint64_t pipeline_id, frontier_item_t& item) {
+  assert(pipeline_id < _num_pipelines);
+  if(_queues[pipeline_id].empty()) {
+    return false;
+  }
+  item = _queues[pipeline_id].front();
+  _queues[pipeline_id].pop_front();
+  _taken[pipeline_id]++;
+  return true;
+}
+
+uint64_t SimObj::Frontier::steal(uint64_t thief_id) {
+  assert(thief_id < _num_pipelines);
+  if(!_stealing) {
+    return 0;
+  }
+  // Victim is the most loaded queue
+  uint64_t victim_id = thief_id;
+  uint64_t victim_size = 0;
+  for(uint64_t i = 0; i < _num_pipelines; i++) {
+    if(i != thief_id && _queues[i].size() > victim_size) {
+      victim_id = i;
+      victim_size = _queues[i].size();
+    }
+  }
+  // Take at most half of the victim's work, rounded down so a lone vertex
+  // is never bounced between idle pipelines. Taken from the back so the
+  // victim keeps streaming from the front undisturbed.
+  uint64_t count = std::min(_steal_batch, victim_size / 2);
+  if(count == 0) {
+    _failed_steals[thief_id]++;
+    return 0;
+  }
+  for(uint64_t i = 0; i < count; i++) {
+    _queues[thief_id].push_front(_queues[victim_id].back());
+    _queues[victim_id].pop_back();
+  }
+  _steals[thief_id]++;
+  _stolen[thief_id] += count;
+  return count;
+}
+
+uint64_t SimObj::Frontier::get_steal_latency(void) {
+  return _steal_latency;
+}
+
+bool SimObj::Frontier::empty(void) {
+  for(auto & queue : _queues) {
+    if(!queue.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SimObj::Frontier::empty(uint64_t pipeline_id) {
+  assert(pipeline_id < _num_pipelines);
+  return _queues[pipeline_id].empty();
+}
+
+uint64_t SimObj::Frontier::size(void) {
+  uint64_t ret = 0;
+  for(auto & queue : _queues) {
+    ret += queue.size();
+  }
+  return ret;
+}
+
+void SimObj::Frontier::clear_stats(void) {
+  std::fill(_distributed.begin(), _distributed.end(), 0);
+  std::fill(_taken.begin(), _taken.end(), 0);
+  std::fill(_steals.begin(), _steals.end(), 0);
+  std::fill(_stolen.begin(), _stolen.end(), 0);
+  std::fill(_failed_steals.begin(), _failed_steals.end(), 0);
+  _split_vertices = 0;
+  _split_chunks = 0;
+}
+
+void SimObj::Frontier::print_stats(void) {
+  uint64_t total = 0;
+  uint64_t max = 0;
+  for(auto & element : _taken) {
+    total += element;
+    max = std::max(max, element);
+  }
+  double mean = (double)total / (double)_num_pipelines;
+  sim_out.write("-------------------------------------------------------------------------------\n");
+  sim_out.write("[ Frontier ]\n");
+  sim_out.write("  Distributed:\n    ");
+  for(auto & element : _distributed) {
+    sim_out.write(std::to_string(element) + ", ");
+  }
+  sim_out.write("\n  Processed:\n    ");
+  for(auto & element : _taken) {
+    sim_out.write(std::to_string(element) + ", ");
+  }
+  sim_out.write("\n  Steals:\n    ");
+  for(auto & element : _steals) {
+    sim_out.write(std::to_string(element) + ", ");
+  }
+  sim_out.write("\n  Stolen Vertices:\n    ");
+  for(auto & element : _stolen) {
+    sim_out.write(std::to_string(element) + ", ");
+  }
+  sim_out.write("\n  Failed Steals:\n    ");
+  for(auto & element : _failed_steals) {
+    sim_out.write(std::to_string(element) + ", ");
+  }
+  sim_out.write("\n  Split Vertices:   " + std::to_string(_split_vertices) + " (" + std::to_string(_split_chunks) + " chunks)\n");
+  sim_out.write("  Load Imbalance (max/mean): " + std::to_string(mean > 0 ? (double)max / mean : 0.0) + "\n");
+}
+
+void SimObj::Frontier::print_stats_csv(void) {
+  uint64_t total = 0;
+  uint64_t max = 0;
+  for(auto & element : _taken) {
+    total += element;
+    max = std::max(max, element);
+  }
+  double mean = (double)total / (double)_num_pipelines;
+  sim_out.write("Frontier,");
+  sim_out.write("distributed,");
+  for(auto & element : _distributed) {
+    sim_out.write(std::to_string(element) + ",");
+  }
+  sim_out.write("processed,");
+  for(auto & element : _taken) {
+    sim_out.write(std::to_string(element) + ",");
+  }
+  sim_out.write("steals,");
+  for(auto & element : _steals) {
+    sim_out.write(std::to_string(element) + ",");
+  }
+  sim_out.write("stolen,");
+  for(auto & element : _stolen) {
+    sim_out.write(std::to_string(element) + ",");
+  }
+  sim_out.write("failed_steals,");
+  for(auto & element : _failed_steals) {
+    sim_out.write(std::to_string(element) + ",");
+  }
+  sim_out.write("split_vertices," + std::to_string(_split_vertices) + ",");
+  sim_out.write("split_chunks," + std::to_string(_split_chunks) + ",");
+  sim_out.write("imbalance," + std::to_string(mean > 0 ? (double)max / mean : 0.0) + "\n");
+}
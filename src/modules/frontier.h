@@ -0,0 +1,94 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Frontier:
+ *  Per-pipeline active vertex queues. At the start of the processing phase
+ *  the global frontier is distributed to the pipeline owning each vertex.
+ *  A pipeline whose queue runs dry steals a batch of vertices from the back
+ *  of the most loaded queue, paying a fixed steal latency.
+ *  Entries are (vertex, first edge) pairs so a split high-degree vertex can
+ *  be queued as several chunks on different pipelines.
+ *
+ */
+
+#ifndef FRONTIER_H
+#define FRONTIER_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "atomicQueue.h"
+
+namespace SimObj {
+
+struct frontier_item_t {
+  uint64_t vertex_id;
+  uint64_t edge_start;
+};
+
+class Frontier {
+private:
+  uint64_t _num_pipelines;
+  bool _stealing;
+  uint64_t _steal_latency;
+  uint64_t _steal_batch;
+  std::vector<std::deque<frontier_item_t>> _queues;
+
+  // Stats
+  std::vector<uint64_t> _distributed;
+  std::vector<uint64_t> _taken;
+  std::vector<uint64_t> _steals;
+  std::vector<uint64_t> _stolen;
+  std::vector<uint64_t> _failed_steals; // Cycles idle with nothing to steal
+  uint64_t _split_vertices;
+  uint64_t _split_chunks;
+
+public:
+  Frontier(uint64_t num_pipelines, bool stealing, uint64_t steal_latency, uint64_t steal_batch);
+  ~Frontier();
+
+  // Drain the global frontier into the owning pipelines' queues. The
+  // callbacks give the chunk count and first edge of chunk c of a vertex.
+  template<class chunks_f, class start_f>
+  void distribute(Utility::AtomicQueue<uint64_t>* process, chunks_f num_chunks, start_f chunk_start);
+  void push(uint64_t pipeline_id, uint64_t vertex_id, uint64_t edge_start);
+
+  // Pop from the pipeline's own queue, false if it is empty
+  bool pop(uint64_t pipeline_id, frontier_item_t& item);
+
+  // Move a batch from the most loaded queue into the thief's queue, returns
+  // the number of vertices moved (0 if stealing is off or nothing to steal).
+  // Thieves retry every cycle, so failed steals count their idle cycles.
+  uint64_t steal(uint64_t thief_id);
+  uint64_t get_steal_latency(void);
+
+  bool empty(void);
+  bool empty(uint64_t pipeline_id);
+  uint64_t size(void);
+
+  void clear_stats(void);
+  void print_stats(void);
+  void print_stats_csv(void);
+}; // class Frontier
+
+} // namespace SimObj
+
+template<class chunks_f, class start_f>
+void SimObj::Frontier::distribute(Utility::AtomicQueue<uint64_t>* process, chunks_f num_chunks, start_f chunk_start) {
+  uint64_t vertex_id;
+  while(process->pop(vertex_id)) {
+    // Chunk c of a split vertex goes to the pipeline after chunk c-1's
+    uint64_t chunks = num_chunks(vertex_id);
+    for(uint64_t chunk = 0; chunk < chunks; chunk++) {
+      push((vertex_id + chunk) % _num_pipelines, vertex_id, chunk_start(vertex_id, chunk));
+    }
+    if(chunks > 1) {
+      _split_vertices++;
+      _split_chunks += chunks;
+    }
+  }
+}
+
+#endif // FRONTIER_H
@@ -0,0 +1,109 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Functional Engine:
+ *  Decoupled functional front-end for the timing pipelines. For every slice
+ *  of an iteration host threads walk each pipeline's share of the frontier
+ *  and produce the ordered streams of source vertex and (edge, dst, update)
+ *  events into bounded rings. ReadSrcProperty and ReadSrcEdges consume the
+ *  streams instead of reading the graph, and ProcessEdge forwards the
+ *  precomputed update instead of running the app.
+ *
+ *  The vertex and edge streams of a pipeline have their own producer thread.
+ *  A consumer finding its ring empty blocks the host until the event arrives,
+ *  so simulated timing does not depend on host scheduling.
+ *
+ */
+
+#ifndef FUNCTIONAL_ENGINE_H
+#define FUNCTIONAL_ENGINE_H
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ringBuffer.h"
+#include "readGraph.h"
+#include "graphMat.h"
+#include "log.h"
+
+namespace SimObj {
+
+template<class v_t>
+struct vertex_event_t {
+  uint64_t vertex_id;
+  uint64_t edge_begin;
+  v_t data;
+  bool end; // No more vertices this slice
+};
+
+template<class v_t, class e_t>
+struct edge_event_t {
+  uint64_t edge_id;
+  uint64_t dst;
+  e_t weight;
+  v_t update;
+};
+
+template<class v_t, class e_t>
+class FunctionalStream {
+private:
+  Utility::RingBuffer<vertex_event_t<v_t>> _vertices;
+  Utility::RingBuffer<edge_event_t<v_t, e_t>> _edges;
+
+  // Stats
+  uint64_t _vertex_events;
+  uint64_t _edge_events;
+
+public:
+  FunctionalStream(uint64_t capacity);
+  ~FunctionalStream();
+
+  // Producer side
+  void push_vertex(const vertex_event_t<v_t>& event);
+  void push_edge(const edge_event_t<v_t, e_t>& event);
+
+  // Consumer side
+  // Returns false once the slice's vertices have all been read
+  bool pop_vertex(vertex_event_t<v_t>& event);
+  edge_event_t<v_t, e_t> pop_edge(void);
+
+  void print_stats_csv(const std::string& name);
+  void clear_stats(void);
+};
+
+template<class v_t, class e_t>
+class FunctionalEngine {
+private:
+  uint64_t _num_pipelines;
+  Utility::readGraph<v_t>* _graph;
+  GraphMat::GraphApp<v_t, e_t>* _graph_app;
+  std::vector<FunctionalStream<v_t, e_t>*> _streams;
+  std::vector<std::thread> _threads;
+  std::vector<uint64_t> _frontier;
+
+  void produce_vertices(uint64_t pipeline_id);
+  void produce_edges(uint64_t pipeline_id);
+
+public:
+  FunctionalEngine(uint64_t num_pipelines, uint64_t capacity, Utility::readGraph<v_t>* graph, GraphMat::GraphApp<v_t, e_t>* graph_app);
+  ~FunctionalEngine();
+
+  FunctionalStream<v_t, e_t>* get_stream(uint64_t pipeline_id);
+
+  // Start producing the active slice for frontier, vertices go round-robin
+  void start(const std::vector<uint64_t>& frontier);
+  // Wait for the producers, every stream has been read to its end
+  void join(void);
+
+  void print_stats_csv(void);
+  void clear_stats(void);
+};
+
+} // namespace SimObj
+
+#include "functionalEngine.tcc"
+
+#endif
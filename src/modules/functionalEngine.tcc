@@ -0,0 +1,164 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Functional Engine:
+ *  Decoupled functional front-end for the timing pipelines.
+ *
+ */
+
+#include <cassert>
+
+template<class v_t, class e_t>
+SimObj::FunctionalStream<v_t, e_t>::FunctionalStream(uint64_t capacity) : _vertices(capacity), _edges(capacity) {
+  _vertex_events = 0;
+  _edge_events = 0;
+}
+
+template<class v_t, class e_t>
+SimObj::FunctionalStream<v_t, e_t>::~FunctionalStream() {
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalStream<v_t, e_t>::push_vertex(const vertex_event_t<v_t>& event) {
+  while(!_vertices.push(event)) {
+    std::this_thread::yield();
+  }
+  if(!event.end) {
+    _vertex_events++;
+  }
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalStream<v_t, e_t>::push_edge(const edge_event_t<v_t, e_t>& event) {
+  while(!_edges.push(event)) {
+    std::this_thread::yield();
+  }
+  _edge_events++;
+}
+
+template<class v_t, class e_t>
+bool SimObj::FunctionalStream<v_t, e_t>::pop_vertex(vertex_event_t<v_t>& event) {
+  while(!_vertices.pop(event)) {
+    std::this_thread::yield();
+  }
+  return !event.end;
+}
+
+template<class v_t, class e_t>
+SimObj::edge_event_t<v_t, e_t> SimObj::FunctionalStream<v_t, e_t>::pop_edge(void) {
+  // Only called for edges ReadSrcEdges knows exist
+  edge_event_t<v_t, e_t> event;
+  while(!_edges.pop(event)) {
+    std::this_thread::yield();
+  }
+  return event;
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalStream<v_t, e_t>::print_stats_csv(const std::string& name) {
+  sim_out.write(name + ",vertex_events," + std::to_string(_vertex_events) +
+                ",edge_events," + std::to_string(_edge_events) + "\n");
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalStream<v_t, e_t>::clear_stats(void) {
+  _vertex_events = 0;
+  _edge_events = 0;
+}
+
+
+template<class v_t, class e_t>
+SimObj::FunctionalEngine<v_t, e_t>::FunctionalEngine(uint64_t num_pipelines, uint64_t capacity, Utility::readGraph<v_t>* graph, GraphMat::GraphApp<v_t, e_t>* graph_app) {
+  assert(num_pipelines > 0);
+  assert(graph != NULL);
+  assert(graph_app != NULL);
+  _num_pipelines = num_pipelines;
+  _graph = graph;
+  _graph_app = graph_app;
+  for(uint64_t i = 0; i < num_pipelines; i++) {
+    _streams.push_back(new FunctionalStream<v_t, e_t>(capacity));
+  }
+}
+
+template<class v_t, class e_t>
+SimObj::FunctionalEngine<v_t, e_t>::~FunctionalEngine() {
+  join();
+  for(auto & stream : _streams) {
+    delete stream;
+  }
+  _graph = NULL;
+  _graph_app = NULL;
+}
+
+template<class v_t, class e_t>
+SimObj::FunctionalStream<v_t, e_t>* SimObj::FunctionalEngine<v_t, e_t>::get_stream(uint64_t pipeline_id) {
+  assert(pipeline_id < _num_pipelines);
+  return _streams[pipeline_id];
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalEngine<v_t, e_t>::produce_vertices(uint64_t pipeline_id) {
+  FunctionalStream<v_t, e_t>* stream = _streams[pipeline_id];
+  vertex_event_t<v_t> event;
+  event.end = false;
+  for(uint64_t i = pipeline_id; i < _frontier.size(); i += _num_pipelines) {
+    event.vertex_id = _frontier[i];
+    event.edge_begin = _graph->getEdgeBegin(event.vertex_id);
+    event.data = _graph->getVertexProperty(event.vertex_id);
+    stream->push_vertex(event);
+  }
+  event.end = true;
+  stream->push_vertex(event);
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalEngine<v_t, e_t>::produce_edges(uint64_t pipeline_id) {
+  FunctionalStream<v_t, e_t>* stream = _streams[pipeline_id];
+  edge_event_t<v_t, e_t> event;
+  for(uint64_t i = pipeline_id; i < _frontier.size(); i += _num_pipelines) {
+    uint64_t vertex = _frontier[i];
+    v_t src_data = _graph->getVertexProperty(vertex);
+    uint64_t end = _graph->getEdgeEnd(vertex);
+    for(uint64_t pos = _graph->getEdgeBegin(vertex); pos < end; pos++) {
+      event.edge_id = _graph->getEdgeAt(pos);
+      event.dst = _graph->getNodeNeighbor(event.edge_id);
+      event.weight = _graph->getEdgeWeight(event.edge_id);
+      event.update = v_t();
+      _graph_app->process_edge(event.update, event.weight, src_data);
+      stream->push_edge(event);
+    }
+  }
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalEngine<v_t, e_t>::start(const std::vector<uint64_t>& frontier) {
+  assert(_threads.empty());
+  _frontier = frontier;
+  for(uint64_t i = 0; i < _num_pipelines; i++) {
+    _threads.push_back(std::thread(&FunctionalEngine<v_t, e_t>::produce_vertices, this, i));
+    _threads.push_back(std::thread(&FunctionalEngine<v_t, e_t>::produce_edges, this, i));
+  }
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalEngine<v_t, e_t>::join(void) {
+  for(auto & thread : _threads) {
+    thread.join();
+  }
+  _threads.clear();
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalEngine<v_t, e_t>::print_stats_csv(void) {
+  for(uint64_t i = 0; i < _num_pipelines; i++) {
+    _streams[i]->print_stats_csv("FunctionalStream " + std::to_string(i));
+  }
+}
+
+template<class v_t, class e_t>
+void SimObj::FunctionalEngine<v_t, e_t>::clear_stats(void) {
+  for(auto & stream : _streams) {
+    stream->clear_stats();
+  }
+}
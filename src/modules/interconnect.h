@@ -0,0 +1,67 @@
+/*
+ * Andrew Smith
+ *
+ * Interconnect Pipeline Module
+ *  Base of the networks moving edges between pipelines, a Crossbar or a
+ *  NoC::Network. Each pipeline owns one port: its ReadSrcEdges sends into
+ *  the port's input and its ReadDstProperty receives from the port's output.
+ *  Edges are routed to the pipeline owning their destination vertex.
+ *
+ */
+
+#ifndef INTERCONNECT_H
+#define INTERCONNECT_H
+
+#include <vector>
+
+#include "module.h"
+
+namespace SimObj {
+
+template<class v_t, class e_t>
+class Interconnect;
+
+// Input port of an interconnect, the next module of a pipeline's ReadSrcEdges
+template<class v_t, class e_t>
+class InterconnectInput : public Module<v_t, e_t> {
+private:
+  Interconnect<v_t, e_t>* _interconnect;
+  uint64_t _port;
+
+public:
+  InterconnectInput(Interconnect<v_t, e_t>* interconnect, uint64_t port);
+  ~InterconnectInput();
+
+  stall_t is_stalled(const Utility::pipeline_data<v_t, e_t>& data);
+  void ready(const Utility::pipeline_data<v_t, e_t>& data);
+};
+
+template<class v_t, class e_t>
+class Interconnect : public Module<v_t, e_t> {
+protected:
+  uint64_t _num_ports;
+  std::vector<InterconnectInput<v_t, e_t>*> _inputs;
+  std::vector<Module<v_t, e_t>*> _in_module;
+  std::vector<Module<v_t, e_t>*> _out_module;
+
+  uint64_t route(const Utility::pipeline_data<v_t, e_t>& vertex) {
+    return vertex.vertex_dst_id % _num_ports;
+  }
+
+public:
+  Interconnect(uint64_t num_ports);
+  virtual ~Interconnect();
+
+  void connect_input(Module<v_t, e_t>* in_module, uint64_t port_num);
+  void connect_output(Module<v_t, e_t>* out_module, uint64_t port_num);
+  Module<v_t, e_t>* get_input(uint64_t port_num);
+
+  virtual stall_t is_stalled(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data) = 0;
+  virtual void ready(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data) = 0;
+};
+
+} // namespace SimObj
+
+#include "interconnect.tcc"
+
+#endif
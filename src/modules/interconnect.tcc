@@ -0,0 +1,70 @@
+/*
+ * Andrew Smith
+ *
+ * Interconnect Pipeline Module
+ *
+ */
+
+#include <cassert>
+
+template<class v_t, class e_t>
+SimObj::InterconnectInput<v_t, e_t>::InterconnectInput(Interconnect<v_t, e_t>* interconnect, uint64_t port) {
+  assert(interconnect != NULL);
+  _interconnect = interconnect;
+  _port = port;
+}
+
+template<class v_t, class e_t>
+SimObj::InterconnectInput<v_t, e_t>::~InterconnectInput() {
+  _interconnect = NULL;
+}
+
+template<class v_t, class e_t>
+SimObj::stall_t SimObj::InterconnectInput<v_t, e_t>::is_stalled(const Utility::pipeline_data<v_t, e_t>& data) {
+  return _interconnect->is_stalled(_port, data);
+}
+
+template<class v_t, class e_t>
+void SimObj::InterconnectInput<v_t, e_t>::ready(const Utility::pipeline_data<v_t, e_t>& data) {
+  _interconnect->ready(_port, data);
+}
+
+
+template<class v_t, class e_t>
+SimObj::Interconnect<v_t, e_t>::Interconnect(uint64_t num_ports) {
+  assert(num_ports > 0);
+  _num_ports = num_ports;
+  for(uint64_t i = 0; i < num_ports; i++) {
+    _inputs.push_back(new InterconnectInput<v_t, e_t>(this, i));
+  }
+  _in_module.resize(num_ports);
+  _out_module.resize(num_ports);
+}
+
+template<class v_t, class e_t>
+SimObj::Interconnect<v_t, e_t>::~Interconnect() {
+  for(auto & input : _inputs) {
+    delete input;
+    input = NULL;
+  }
+}
+
+template<class v_t, class e_t>
+void SimObj::Interconnect<v_t, e_t>::connect_input(Module<v_t, e_t>* in_module, uint64_t port_num) {
+  assert(port_num < _num_ports);
+  assert(in_module != NULL);
+  _in_module[port_num] = in_module;
+}
+
+template<class v_t, class e_t>
+void SimObj::Interconnect<v_t, e_t>::connect_output(Module<v_t, e_t>* out_module, uint64_t port_num) {
+  assert(port_num < _num_ports);
+  assert(out_module != NULL);
+  _out_module[port_num] = out_module;
+}
+
+template<class v_t, class e_t>
+SimObj::Module<v_t, e_t>* SimObj::Interconnect<v_t, e_t>::get_input(uint64_t port_num) {
+  assert(port_num < _num_ports);
+  return _inputs[port_num];
+}
@@ -0,0 +1,229 @@
+/*
+ * Andrew Smith
+ *
+ * Banked DRAM. Derived from Memory class.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "bankedDram.h"
+#include "iniReader.h"
+#include "log.h"
+
+SimObj::BankedDRAM::BankedDRAM(const std::string& device_ini, const std::string& system_ini, uint64_t megs) {
+  Utility::IniReader device(device_ini);
+  Utility::IniReader system(system_ini);
+
+  uint64_t burst_length = device.get_uint("BL", 8);
+  _tRCD = device.get_uint("tRCD", 10);
+  _tRP = device.get_uint("tRP", 10);
+  _tRAS = device.get_uint("tRAS", 24);
+  _tRRD = device.get_uint("tRRD", 4);
+  _tCCD = device.get_uint("tCCD", 4);
+  _tRTP = device.get_uint("tRTP", 5);
+  _tWR = device.get_uint("tWR", 10);
+  _AL = device.get_uint("AL", 0);
+  _read_latency = device.get_uint("CL", 10) + _AL;
+  // DRAMSim2 has WL = RL - 1, an ini may set it but it can not go below 0
+  _write_latency = device.get_uint("WL", _read_latency > 0 ? _read_latency - 1 : 0);
+  _burst_cycles = burst_length / 2;
+
+  uint64_t bus_bits = system.get_uint("JEDEC_DATA_BUS_BITS", 64);
+  _num_channels = system.get_uint("NUM_CHANS", 1);
+  _num_banks = device.get_uint("NUM_BANKS", 8);
+  _num_rows = device.get_uint("NUM_ROWS", 32768);
+  _columns = device.get_uint("NUM_COLS", 2048) / burst_length;
+  _transaction_size = bus_bits / 8 * burst_length;
+  _queue_depth = system.get_uint("TRANS_QUEUE_DEPTH", 32);
+  _row_access_cap = system.get_uint("TOTAL_ROW_ACCESSES", 4);
+  assert(_num_channels >= 1 && _num_banks >= 1 && _columns >= 1 && _queue_depth >= 1);
+
+  // Ranks are whatever it takes to reach the requested capacity
+  uint64_t rank_bytes = _num_rows * device.get_uint("NUM_COLS", 2048) * _num_banks * bus_bits / 8;
+  _num_ranks = std::max<uint64_t>(1, (megs << 20) / _num_channels / rank_bytes);
+
+  bank_t bank = {false, 0, 0, 0, 0, 0};
+  _channels.resize(_num_channels);
+  for(auto & channel : _channels) {
+    channel.banks.assign(_num_ranks * _num_banks, bank);
+    channel.bus_free = 0;
+    channel.next_act = 0;
+    channel.next_event = UINT64_MAX;
+  }
+  _next_event = UINT64_MAX;
+  clear_stats();
+}
+
+SimObj::BankedDRAM::~BankedDRAM() {
+  // Do Nothing
+}
+
+void SimObj::BankedDRAM::enqueue(uint64_t addr, bool* complete, mem_op_t type) {
+  update_row_stats(addr);
+  // row:col:rank:bank:chan, consecutive transactions spread over channels then banks
+  uint64_t line = addr / _transaction_size;
+  channel_t& channel = _channels[line % _num_channels];
+  line /= _num_channels;
+  uint64_t bank = line % _num_banks;
+  line /= _num_banks;
+  uint64_t rank = line % _num_ranks;
+  line /= _num_ranks;
+  line /= _columns;
+  channel.queue.push_back({complete, type, _tick, rank * _num_banks + bank, line % _num_rows});
+  channel.next_event = std::min(channel.next_event, _tick + 1);
+  _next_event = std::min(_next_event, _tick + 1);
+}
+
+uint64_t SimObj::BankedDRAM::issue_tick(const channel_t& channel, const request_t& req) const {
+  const bank_t& bank = channel.banks[req.bank];
+  if(bank.open && bank.open_row == req.row) {
+    uint64_t latency = (req.type == MEM_READ) ? _read_latency : _write_latency;
+    return std::max(bank.next_col, channel.bus_free > latency ? channel.bus_free - latency : 0);
+  }
+  if(bank.open) {
+    return bank.next_pre;
+  }
+  return std::max(bank.next_act, channel.next_act);
+}
+
+void SimObj::BankedDRAM::commit(channel_t& channel, const request_t& req) {
+  bank_t& bank = channel.banks[req.bank];
+  uint64_t latency = (req.type == MEM_READ) ? _read_latency : _write_latency;
+  uint64_t col;
+  if(bank.open && bank.open_row == req.row) {
+    col = std::max(_tick, bank.next_col);
+    _hits++;
+  }
+  else {
+    uint64_t act = _tick;
+    if(bank.open) {
+      // Precharge the open row first
+      act = std::max(_tick, bank.next_pre) + _tRP;
+      _conflicts++;
+    }
+    else {
+      _misses++;
+    }
+    act = std::max({act, bank.next_act, channel.next_act});
+    channel.next_act = act + _tRRD;
+    bank.open = true;
+    bank.open_row = req.row;
+    bank.row_accesses = 0;
+    bank.next_pre = act + _tRAS;
+    col = act + _tRCD;
+  }
+  // Line the data burst up behind the one already on the bus
+  if(channel.bus_free > latency) {
+    col = std::max(col, channel.bus_free - latency);
+  }
+  uint64_t finish = col + latency + _burst_cycles;
+  channel.bus_free = finish;
+  bank.next_col = col + std::max(_tCCD, _burst_cycles);
+  bank.row_accesses++;
+  if(req.type == MEM_READ) {
+    bank.next_pre = std::max(bank.next_pre, col + _AL + _tRTP);
+  }
+  else {
+    bank.next_pre = std::max(bank.next_pre, finish + _tWR);
+  }
+  _completions.emplace(finish, req.complete);
+  _latency += finish - req.arrival;
+  _bus_cycles += _burst_cycles;
+}
+
+void SimObj::BankedDRAM::schedule(channel_t& channel) {
+  // FR-FCFS over the oldest _queue_depth requests, one command per cycle
+  uint64_t window = std::min<uint64_t>(channel.queue.size(), _queue_depth);
+  uint64_t earliest = UINT64_MAX;
+  int64_t best = -1;
+  for(uint64_t i = 0; i < window; i++) {
+    const request_t& req = channel.queue[i];
+    uint64_t ready = issue_tick(channel, req);
+    if(ready > _tick) {
+      earliest = std::min(earliest, ready);
+      continue;
+    }
+    const bank_t& bank = channel.banks[req.bank];
+    if(bank.open && bank.open_row == req.row && bank.row_accesses < _row_access_cap) {
+      best = i;
+      break;
+    }
+    if(best < 0) {
+      best = i;
+    }
+  }
+  if(best < 0) {
+    channel.next_event = earliest;
+    return;
+  }
+  commit(channel, channel.queue[best]);
+  channel.queue.erase(channel.queue.begin() + best);
+  channel.next_event = channel.queue.empty() ? UINT64_MAX : _tick + 1;
+}
+
+void SimObj::BankedDRAM::tick(void) {
+  _tick++;
+  _cycles++;
+  if(_tick < _next_event) {
+    return;
+  }
+  while(!_completions.empty() && _completions.top().first <= _tick) {
+    *_completions.top().second = true;
+    _completions.pop();
+  }
+  _next_event = _completions.empty() ? UINT64_MAX : _completions.top().first;
+  for(auto & channel : _channels) {
+    if(channel.next_event <= _tick) {
+      schedule(channel);
+    }
+    _next_event = std::min(_next_event, channel.next_event);
+  }
+  // A request committed this tick may finish before the current next event
+  if(!_completions.empty()) {
+    _next_event = std::min(_next_event, _completions.top().first);
+  }
+}
+
+void SimObj::BankedDRAM::write(uint64_t addr, bool* complete, bool sequential) {
+  _writes++;
+  enqueue(addr, complete, MEM_WRITE);
+}
+
+void SimObj::BankedDRAM::read(uint64_t addr, bool* complete, bool sequential) {
+  _reads++;
+  enqueue(addr, complete, MEM_READ);
+}
+
+uint64_t SimObj::BankedDRAM::get_bytes(void) {
+  return (_reads + _writes) * _transaction_size;
+}
+
+void SimObj::BankedDRAM::print_stats() {
+  Memory::print_stats();
+}
+
+void SimObj::BankedDRAM::print_stats_csv() {
+  uint64_t committed = _hits + _misses + _conflicts;
+  sim_out.write("BankedDRAM," + std::to_string(_channel) +
+                ",reads," + std::to_string(_reads) +
+                ",writes," + std::to_string(_writes) +
+                ",row_hits," + std::to_string(_hits) +
+                ",row_misses," + std::to_string(_misses) +
+                ",row_conflicts," + std::to_string(_conflicts) +
+                ",avg_latency," + std::to_string(committed ? (double)_latency / (double)committed : 0.0) +
+                ",bus_utilization," + std::to_string(_cycles ? (double)_bus_cycles / (double)(_cycles * _num_channels) : 0.0) + "\n");
+}
+
+void SimObj::BankedDRAM::clear_stats() {
+  _reads = 0;
+  _writes = 0;
+  _hits = 0;
+  _misses = 0;
+  _conflicts = 0;
+  _latency = 0;
+  _bus_cycles = 0;
+  _cycles = 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Andrew Smith
+ *
+ * Banked DRAM. Derived from Memory class, a native DRAM timing model that
+ * reads the same device and system .ini files as DRAMSim2. Each channel
+ * tracks the open row of every rank and bank and schedules its queue
+ * FR-FCFS (oldest row hit first, then oldest request) under the tRCD, CL,
+ * tRP, tRAS, tRRD, tCCD, tRTP and tWR constraints. Work is only done on
+ * the ticks where a request can issue or complete.
+ *
+ */
+
+#ifndef BANKED_DRAM_H
+#define BANKED_DRAM_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory.h"
+
+namespace SimObj {
+
+class BankedDRAM : public Memory {
+private:
+  struct request_t {
+    bool* complete;
+    mem_op_t type;
+    uint64_t arrival;
+    uint64_t bank;   // rank * banks + bank
+    uint64_t row;
+  };
+
+  struct bank_t {
+    bool open;
+    uint64_t open_row;
+    uint64_t row_accesses;
+    uint64_t next_act;
+    uint64_t next_pre;
+    uint64_t next_col;
+  };
+
+  struct channel_t {
+    std::deque<request_t> queue;
+    std::vector<bank_t> banks;
+    uint64_t bus_free;
+    uint64_t next_act;
+    uint64_t next_event;
+  };
+
+  // Device timing in memory cycles
+  uint64_t _tRCD;
+  uint64_t _tRP;
+  uint64_t _tRAS;
+  uint64_t _tRRD;
+  uint64_t _tCCD;
+  uint64_t _tRTP;
+  uint64_t _tWR;
+  uint64_t _AL;
+  uint64_t _read_latency;
+  uint64_t _write_latency;
+  uint64_t _burst_cycles;
+
+  // Organisation
+  uint64_t _num_channels;
+  uint64_t _num_ranks;
+  uint64_t _num_banks;
+  uint64_t _num_rows;
+  uint64_t _columns;
+  uint64_t _transaction_size;
+  uint64_t _queue_depth;
+  uint64_t _row_access_cap;
+
+  std::vector<channel_t> _channels;
+  std::priority_queue<std::pair<uint64_t, bool*>, std::vector<std::pair<uint64_t, bool*>>, std::greater<std::pair<uint64_t, bool*>>> _completions;
+  uint64_t _next_event;
+
+  // Stats
+  uint64_t _reads;
+  uint64_t _writes;
+  uint64_t _hits;
+  uint64_t _misses;
+  uint64_t _conflicts;
+  uint64_t _latency;
+  uint64_t _bus_cycles;
+  uint64_t _cycles;
+
+  void enqueue(uint64_t addr, bool* complete, mem_op_t type);
+  uint64_t issue_tick(const channel_t& channel, const request_t& req) const;
+  void commit(channel_t& channel, const request_t& req);
+  void schedule(channel_t& channel);
+
+public:
+  BankedDRAM(const std::string& device_ini, const std::string& system_ini, uint64_t megs);
+  ~BankedDRAM();
+
+  void tick(void);
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+  uint64_t get_bytes(void);
+  void print_stats();
+  void print_stats_csv();
+  void clear_stats();
+}; // class BankedDRAM
+
+} // namespace SimObj
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Andrew Smith
+ *
+ * Cache Memory. Derived from Memory class.
+ *
+ */
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "cache.h"
+#include "log.h"
+
+SimObj::replacement_t SimObj::replacement_from_string(const std::string& name) {
+  if(name == "lru") return REPLACE_LRU;
+  if(name == "fifo") return REPLACE_FIFO;
+  if(name == "random") return REPLACE_RANDOM;
+  std::cerr << "[ Cache ] unknown replacement policy: " << name << "\n";
+  assert(false);
+  return REPLACE_LRU;
+}
+
+SimObj::write_policy_t SimObj::write_policy_from_string(const std::string& name) {
+  if(name == "back") return WRITE_BACK;
+  if(name == "through") return WRITE_THROUGH;
+  std::cerr << "[ Cache ] unknown write policy: " << name << "\n";
+  assert(false);
+  return WRITE_BACK;
+}
+
+SimObj::Cache::Cache(Memory* next, uint64_t capacity, uint64_t ways, uint64_t line_size, replacement_t replacement, uint64_t num_mshrs, write_policy_t write_policy, uint64_t hit_latency) : _rng(0) {
+  assert(next != NULL);
+  assert(line_size != 0);
+  assert(ways != 0);
+  assert(num_mshrs != 0);
+  assert(capacity >= ways * line_size);
+  _next = next;
+  _line_size = line_size;
+  _ways = ways;
+  _num_sets = capacity / (ways * line_size);
+  _num_mshrs = num_mshrs;
+  _hit_latency = hit_latency;
+  _replacement = replacement;
+  _write_policy = write_policy;
+  _lines.resize(_num_sets * _ways, line_t{0, false, false, 0, 0});
+  _name = "Cache";
+  clear_stats();
+}
+
+SimObj::Cache::~Cache() {
+  _next = NULL;
+}
+
+SimObj::Cache::line_t* SimObj::Cache::lookup(uint64_t line) {
+  uint64_t set = line % _num_sets;
+  uint64_t tag = line / _num_sets;
+  for(uint64_t way = 0; way < _ways; way++) {
+    line_t* entry = &_lines[set * _ways + way];
+    if(entry->valid && entry->tag == tag) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+void SimObj::Cache::install(uint64_t line, bool dirty) {
+  uint64_t set = line % _num_sets;
+  line_t* victim = NULL;
+  for(uint64_t way = 0; way < _ways && victim == NULL; way++) {
+    if(!_lines[set * _ways + way].valid) {
+      victim = &_lines[set * _ways + way];
+    }
+  }
+  if(victim == NULL) {
+    // Set is full, pick a victim by policy
+    switch(_replacement) {
+      case REPLACE_RANDOM : {
+        victim = &_lines[set * _ways + _rng() % _ways];
+        break;
+      }
+      case REPLACE_FIFO :
+      case REPLACE_LRU :
+      default : {
+        victim = &_lines[set * _ways];
+        for(uint64_t way = 1; way < _ways; way++) {
+          line_t* entry = &_lines[set * _ways + way];
+          uint64_t age = (_replacement == REPLACE_FIFO) ? entry->inserted : entry->last_use;
+          uint64_t victim_age = (_replacement == REPLACE_FIFO) ? victim->inserted : victim->last_use;
+          if(age < victim_age) {
+            victim = entry;
+          }
+        }
+      }
+    }
+    _evictions++;
+    if(victim->dirty) {
+      _dirty_evictions++;
+      _writebacks.push_back(false);
+      _next->write((victim->tag * _num_sets + set) * _line_size, &_writebacks.back());
+    }
+  }
+  victim->tag = line / _num_sets;
+  victim->valid = true;
+  victim->dirty = dirty;
+  victim->last_use = _tick;
+  victim->inserted = _tick;
+}
+
+// Returns false if the request has to wait for a free MSHR
+bool SimObj::Cache::access(uint64_t addr, bool* complete, mem_op_t type) {
+  uint64_t line = addr / _line_size;
+  line_t* entry = lookup(line);
+  if(entry != NULL) {
+    entry->last_use = _tick;
+    if(type == MEM_WRITE) {
+      _write_hits++;
+      if(_write_policy == WRITE_THROUGH) {
+        _next->write(addr, complete);
+        return true;
+      }
+      entry->dirty = true;
+    }
+    else {
+      _read_hits++;
+    }
+    _hits.push_back(std::make_pair(_tick + _hit_latency, complete));
+    return true;
+  }
+  if(type == MEM_WRITE && _write_policy == WRITE_THROUGH) {
+    _write_misses++;
+    _next->write(addr, complete);
+    return true;
+  }
+  auto mshr = _mshr.find(line);
+  if(mshr != _mshr.end()) {
+    _mshr_merges++;
+  }
+  else if(_mshr.size() >= _num_mshrs) {
+    return false;
+  }
+  if(type == MEM_WRITE) {
+    _write_misses++;
+  }
+  else {
+    _read_misses++;
+  }
+  if(mshr == _mshr.end()) {
+    mshr = _mshr.emplace(line, mshr_t{false, false, {}}).first;
+    _next->read(line * _line_size, &mshr->second.fill, false);
+  }
+  mshr->second.dirty |= (type == MEM_WRITE);
+  mshr->second.targets.push_back(complete);
+  return true;
+}
+
+void SimObj::Cache::tick(void) {
+  _tick++;
+  // Finish hits
+  for(auto it = _hits.begin(); it != _hits.end();) {
+    if(it->first <= _tick) {
+      *(it->second) = true;
+      it = _hits.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+  // Install returned lines and wake up the requests waiting on them
+  for(auto it = _mshr.begin(); it != _mshr.end();) {
+    if(it->second.fill) {
+      install(it->first, it->second.dirty);
+      for(auto & target : it->second.targets) {
+        *target = true;
+      }
+      it = _mshr.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+  while(!_writebacks.empty() && _writebacks.front()) {
+    _writebacks.pop_front();
+  }
+  // Retry requests that were waiting on an MSHR, in order
+  while(!_blocked.empty() && access(_blocked.front().addr, _blocked.front().complete, _blocked.front().type)) {
+    _blocked.pop_front();
+  }
+}
+
+void SimObj::Cache::write(uint64_t addr, bool* complete, bool sequential) {
+  if(!_blocked.empty() || !access(addr, complete, MEM_WRITE)) {
+    _mshr_stalls++;
+    _blocked.push_back(request_t{addr, complete, MEM_WRITE});
+  }
+}
+
+void SimObj::Cache::read(uint64_t addr, bool* complete, bool sequential) {
+  if(!_blocked.empty() || !access(addr, complete, MEM_READ)) {
+    _mshr_stalls++;
+    _blocked.push_back(request_t{addr, complete, MEM_READ});
+  }
+}
+
+void SimObj::Cache::set_name(std::string name) {
+  _name = name;
+}
+
+void SimObj::Cache::print_stats() {
+  uint64_t accesses = _read_hits + _read_misses + _write_hits + _write_misses;
+  sim_out.write("-------------------------------------------------------------------------------\n");
+  sim_out.write("[ " + _name + " ]\n");
+  sim_out.write("  Read Hits:        " + std::to_string(_read_hits) + "\n");
+  sim_out.write("  Read Misses:      " + std::to_string(_read_misses) + "\n");
+  sim_out.write("  Write Hits:       " + std::to_string(_write_hits) + "\n");
+  sim_out.write("  Write Misses:     " + std::to_string(_write_misses) + "\n");
+  sim_out.write("  MSHR Merges:      " + std::to_string(_mshr_merges) + "\n");
+  sim_out.write("  MSHR Stalls:      " + std::to_string(_mshr_stalls) + "\n");
+  sim_out.write("  Evictions:        " + std::to_string(_evictions) + "\n");
+  sim_out.write("  Dirty Evictions:  " + std::to_string(_dirty_evictions) + "\n");
+  sim_out.write("  Hit Rate:         " + std::to_string(accesses ? (double)(_read_hits + _write_hits) / (double)accesses : 0.0) + "\n");
+}
+
+void SimObj::Cache::print_stats_csv() {
+  uint64_t accesses = _read_hits + _read_misses + _write_hits + _write_misses;
+  sim_out.write(_name + ","
+    + std::to_string(_read_hits) + ","
+    + std::to_string(_read_misses) + ","
+    + std::to_string(_write_hits) + ","
+    + std::to_string(_write_misses) + ","
+    + std::to_string(_mshr_merges) + ","
+    + std::to_string(_mshr_stalls) + ","
+    + std::to_string(_evictions) + ","
+    + std::to_string(_dirty_evictions) + ","
+    + std::to_string(accesses ? (double)(_read_hits + _write_hits) / (double)accesses : 0.0) + "\n");
+}
+
+void SimObj::Cache::clear_stats() {
+  _read_hits = 0;
+  _read_misses = 0;
+  _write_hits = 0;
+  _write_misses = 0;
+  _mshr_merges = 0;
+  _mshr_stalls = 0;
+  _evictions = 0;
+  _dirty_evictions = 0;
+}
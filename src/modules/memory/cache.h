@@ -0,0 +1,110 @@
+/*
+ * Andrew Smith
+ *
+ * Cache Memory. Derived from Memory class, a set-associative cache that
+ * sits in front of another Memory (usually the DRAM). Only timing and tags
+ * are modeled; the data itself stays in the graph.
+ *
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory.h"
+
+namespace SimObj {
+
+enum replacement_t {
+  REPLACE_LRU,
+  REPLACE_FIFO,
+  REPLACE_RANDOM,
+  REPLACE_NUM_POLICIES
+};
+
+enum write_policy_t {
+  WRITE_BACK,     // Write allocate, dirty lines written on eviction
+  WRITE_THROUGH,  // No write allocate
+  WRITE_NUM_POLICIES
+};
+
+replacement_t replacement_from_string(const std::string& name);
+write_policy_t write_policy_from_string(const std::string& name);
+
+class Cache : public Memory {
+private:
+  struct line_t {
+    uint64_t tag;
+    bool valid;
+    bool dirty;
+    uint64_t last_use;
+    uint64_t inserted;
+  };
+
+  // Outstanding line fill, later misses to the same line merge into it
+  struct mshr_t {
+    bool fill;
+    bool dirty;
+    std::vector<bool*> targets;
+  };
+
+  struct request_t {
+    uint64_t addr;
+    bool* complete;
+    mem_op_t type;
+  };
+
+  Memory* _next;
+  std::string _name;
+  uint64_t _line_size;
+  uint64_t _ways;
+  uint64_t _num_sets;
+  uint64_t _num_mshrs;
+  uint64_t _hit_latency;
+  replacement_t _replacement;
+  write_policy_t _write_policy;
+
+  std::vector<line_t> _lines; // _num_sets x _ways
+  std::map<uint64_t, mshr_t> _mshr;
+  std::list<request_t> _blocked; // Waiting for a free MSHR
+  std::list<std::pair<uint64_t, bool*>> _hits; // Finish tick, flag
+  std::list<bool> _writebacks;
+  std::mt19937 _rng;
+
+  // Stats
+  uint64_t _read_hits;
+  uint64_t _read_misses;
+  uint64_t _write_hits;
+  uint64_t _write_misses;
+  uint64_t _mshr_merges;
+  uint64_t _mshr_stalls;
+  uint64_t _evictions;
+  uint64_t _dirty_evictions;
+
+  line_t* lookup(uint64_t line);
+  void install(uint64_t line, bool dirty);
+  bool access(uint64_t addr, bool* complete, mem_op_t type);
+
+public:
+  Cache(Memory* next, uint64_t capacity, uint64_t ways, uint64_t line_size, replacement_t replacement, uint64_t num_mshrs, write_policy_t write_policy, uint64_t hit_latency);
+  ~Cache();
+
+  void tick(void);
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+  void print_stats();
+  void print_stats_csv();
+  void clear_stats();
+  void set_name(std::string name);
+}; // class Cache
+
+} // namespace SimObj
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Andrew Smith
+ *
+ * Coalescer. Derived from Memory class.
+ *
+ */
+
+#include <cassert>
+#include <string>
+
+#include "coalescer.h"
+#include "log.h"
+
+SimObj::Coalescer::Coalescer(Memory* next, uint64_t line_size) {
+  assert(next != NULL);
+  assert(line_size != 0);
+  _next = next;
+  _line_size = line_size;
+  clear_stats();
+}
+
+SimObj::Coalescer::~Coalescer() {
+  for(auto & element : _reads) {
+    delete element.second.fill;
+  }
+  for(auto & element : _writes) {
+    delete element.second.fill;
+  }
+  _next = NULL;
+}
+
+void SimObj::Coalescer::request(std::map<uint64_t, transaction_t>& pending, uint64_t addr, bool* complete, bool sequential, mem_op_t type) {
+  uint64_t line = addr / _line_size;
+  auto transaction = pending.find(line);
+  if(transaction == pending.end()) {
+    transaction = pending.emplace(line, transaction_t{new bool(false), {}}).first;
+    if(type == MEM_WRITE) {
+      _write_transactions++;
+      _next->write(line * _line_size, transaction->second.fill, sequential);
+    }
+    else {
+      _read_transactions++;
+      _next->read(line * _line_size, transaction->second.fill, sequential);
+    }
+  }
+  transaction->second.waiters.push_back(complete);
+}
+
+void SimObj::Coalescer::complete(std::map<uint64_t, transaction_t>& pending) {
+  for(auto it = pending.begin(); it != pending.end();) {
+    if(*it->second.fill) {
+      for(auto & waiter : it->second.waiters) {
+        *waiter = true;
+      }
+      delete it->second.fill;
+      it = pending.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+}
+
+void SimObj::Coalescer::tick(void) {
+  _tick++;
+  _cycles++;
+  complete(_reads);
+  complete(_writes);
+}
+
+void SimObj::Coalescer::write(uint64_t addr, bool* complete, bool sequential) {
+  _write_requests++;
+  request(_writes, addr, complete, sequential, MEM_WRITE);
+}
+
+void SimObj::Coalescer::read(uint64_t addr, bool* complete, bool sequential) {
+  _read_requests++;
+  request(_reads, addr, complete, sequential, MEM_READ);
+}
+
+void SimObj::Coalescer::print_stats() {
+  uint64_t requests = _read_requests + _write_requests;
+  uint64_t transactions = _read_transactions + _write_transactions;
+  uint64_t bytes = transactions * _line_size;
+  sim_out.write("-------------------------------------------------------------------------------\n");
+  sim_out.write("[ Coalescer " + std::to_string(_channel) + " ]\n");
+  sim_out.write("  Read Requests:       " + std::to_string(_read_requests) + "\n");
+  sim_out.write("  Read Transactions:   " + std::to_string(_read_transactions) + "\n");
+  sim_out.write("  Write Requests:      " + std::to_string(_write_requests) + "\n");
+  sim_out.write("  Write Transactions:  " + std::to_string(_write_transactions) + "\n");
+  sim_out.write("  Coalescing Ratio:    " + std::to_string(transactions ? (double)requests / (double)transactions : 0.0) + "\n");
+  sim_out.write("  Bytes:               " + std::to_string(bytes) + "\n");
+  sim_out.write("  Bytes/Cycle:         " + std::to_string(_cycles ? (double)bytes / (double)_cycles : 0.0) + "\n");
+}
+
+uint64_t SimObj::Coalescer::get_bytes(void) {
+  return _next->get_bytes();
+}
+
+void SimObj::Coalescer::print_stats_csv() {
+  uint64_t requests = _read_requests + _write_requests;
+  uint64_t transactions = _read_transactions + _write_transactions;
+  uint64_t bytes = transactions * _line_size;
+  sim_out.write("Coalescer," + std::to_string(_channel) +
+                ",read_requests," + std::to_string(_read_requests) +
+                ",read_transactions," + std::to_string(_read_transactions) +
+                ",write_requests," + std::to_string(_write_requests) +
+                ",write_transactions," + std::to_string(_write_transactions) +
+                ",coalescing_ratio," + std::to_string(transactions ? (double)requests / (double)transactions : 0.0) +
+                ",bytes," + std::to_string(bytes) +
+                ",bytes_per_cycle," + std::to_string(_cycles ? (double)bytes / (double)_cycles : 0.0) + "\n");
+}
+
+void SimObj::Coalescer::clear_stats() {
+  _read_requests = 0;
+  _write_requests = 0;
+  _read_transactions = 0;
+  _write_transactions = 0;
+  _cycles = 0;
+}
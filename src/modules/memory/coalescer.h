@@ -0,0 +1,59 @@
+/*
+ * Andrew Smith
+ *
+ * Coalescer. Derived from Memory class, shared by all pipelines in front
+ * of the DRAM. Requests to a line that already has a transaction of the
+ * same kind in flight are merged into it and complete with it.
+ *
+ */
+
+#ifndef COALESCER_H
+#define COALESCER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "memory.h"
+
+namespace SimObj {
+
+class Coalescer : public Memory {
+private:
+  struct transaction_t {
+    bool* fill;
+    std::vector<bool*> waiters;
+  };
+
+  Memory* _next;
+  uint64_t _line_size;
+  std::map<uint64_t, transaction_t> _reads;
+  std::map<uint64_t, transaction_t> _writes;
+
+  // Stats
+  uint64_t _read_requests;
+  uint64_t _write_requests;
+  uint64_t _read_transactions;
+  uint64_t _write_transactions;
+  uint64_t _cycles;
+
+  void request(std::map<uint64_t, transaction_t>& pending, uint64_t addr, bool* complete, bool sequential, mem_op_t type);
+  void complete(std::map<uint64_t, transaction_t>& pending);
+
+public:
+  Coalescer(Memory* next, uint64_t line_size);
+  ~Coalescer();
+
+  void tick(void);
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+  uint64_t get_bytes(void);
+  void print_stats();
+  void print_stats_csv();
+  void clear_stats();
+}; // class Coalescer
+
+} // namespace SimObj
+
+#endif
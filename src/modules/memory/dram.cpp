@@ -5,35 +5,51 @@
  *
  */
 
+#ifdef DRAMSIM2
+
 #include <iostream>
 #include <cassert>
 
 #include "dram.h"
+#include "iniReader.h"
 
 SimObj::DRAM::DRAM() {
   _tick = 0;
   _access_latency = 0;
   _write_latency = 0;
-  sequential_write_counter = 0;
-  sequential_read_counter = 0;
-  buffer_size = 16;
 	read_cb = new DRAMSim::Callback<SimObj::DRAM, void, unsigned, uint64_t, uint64_t>(this, &SimObj::DRAM::read_complete);
 	write_cb = new DRAMSim::Callback<SimObj::DRAM, void, unsigned, uint64_t, uint64_t>(this, &SimObj::DRAM::write_complete);
   _mem = DRAMSim::getMemorySystemInstance("DDR3_micron_64M_8B_x4_sg15.ini", "graphicionado_system.ini", "./modules/memory", "g_sim", 65536);
 	_mem->RegisterCallbacks(read_cb, write_cb, NULL);
+  // 64 data bits, BL8
+  _transaction_size = 64;
+  _bytes = 0;
 }
 
 SimObj::DRAM::DRAM(uint64_t access_latency, uint64_t write_latency, uint64_t num_simultaneous_requests) {
   _tick = 0;
   _access_latency = access_latency;
   _write_latency = write_latency;
-  sequential_write_counter = 0;
-  sequential_read_counter = 0;
-  buffer_size = 16;
 	read_cb = new DRAMSim::Callback<SimObj::DRAM, void, unsigned, uint64_t, uint64_t>(this, &SimObj::DRAM::read_complete);
 	write_cb = new DRAMSim::Callback<SimObj::DRAM, void, unsigned, uint64_t, uint64_t>(this, &SimObj::DRAM::write_complete);
   _mem = DRAMSim::getMemorySystemInstance("DDR3_micron_64M_8B_x4_sg15.ini", "graphicionado_system.ini", "./modules/memory", "g_sim", 65536);
 	_mem->RegisterCallbacks(read_cb, write_cb, NULL);
+  // 64 data bits, BL8
+  _transaction_size = 64;
+  _bytes = 0;
+}
+
+SimObj::DRAM::DRAM(const std::string& device_ini, const std::string& system_ini, uint64_t megs) {
+  _tick = 0;
+  _access_latency = 0;
+  _write_latency = 0;
+	read_cb = new DRAMSim::Callback<SimObj::DRAM, void, unsigned, uint64_t, uint64_t>(this, &SimObj::DRAM::read_complete);
+	write_cb = new DRAMSim::Callback<SimObj::DRAM, void, unsigned, uint64_t, uint64_t>(this, &SimObj::DRAM::write_complete);
+  // An empty working directory makes DRAMSim2 use the paths as given
+  _mem = DRAMSim::getMemorySystemInstance(device_ini, system_ini, "", "g_sim", megs);
+	_mem->RegisterCallbacks(read_cb, write_cb, NULL);
+  _transaction_size = Utility::IniReader(system_ini).get_uint("JEDEC_DATA_BUS_BITS", 64) / 8 * Utility::IniReader(device_ini).get_uint("BL", 8);
+  _bytes = 0;
 }
 
 SimObj::DRAM::~DRAM() {
@@ -50,20 +66,11 @@ void SimObj::DRAM::write(uint64_t addr, bool* complete, bool sequential) {
 #ifdef DEBUG
   //std::cout << "DRAM Write Issued @ " << _tick << " with address: " << std::hex << addr << "\n";
 #endif
-#if 0
-  if(sequential) {
-    // check if the sequential read buffer has data:
-    if(sequential_write_counter < buffer_size) {
-      // Can directly complete the req:
-      *complete = true;
-      sequential_write_counter++;
-      return;
-    }
-  }
-#endif
+  update_row_stats(addr);
   if(_mem->addTransaction(true, addr)) {
     std::tuple<uint64_t, bool*, bool> transaction = std::make_tuple(addr, complete, sequential);
     _write_queue.push_back(transaction);
+    _bytes += _transaction_size;
     return;
   }
   assert(1==0); // Shouldnt reach here?
@@ -73,20 +80,11 @@ void SimObj::DRAM::read(uint64_t addr, bool* complete, bool sequential) {
 #ifdef DEBUG
   //std::cout << "DRAM Read  Issued @ " << _tick << " with address: " << std::hex << addr << "\n";
 #endif
-#if 0
-  if(sequential) {
-    // check if the sequential read buffer has data:
-    if(sequential_read_counter < buffer_size) {
-      // Can directly complete the req:
-      *complete = true;
-      sequential_read_counter++;
-      return;
-    }
-  }
-#endif
+  update_row_stats(addr);
   if(_mem->addTransaction(false, addr)) {
     std::tuple<uint64_t, bool*, bool> transaction = std::make_tuple(addr, complete, sequential);
     _read_queue.push_back(transaction);
+    _bytes += _transaction_size;
     return;
   }
   assert(1==0); // Shouldnt reach here?
@@ -98,9 +96,6 @@ void SimObj::DRAM::read_complete(unsigned int id, uint64_t address, uint64_t clo
     if(std::get<0>(*it) == address) {
       // Set the complete flag to true
       *(std::get<1>(*it)) = true;
-      if(std::get<2>(*it) == true) {
-        sequential_read_counter = 0;
-      }
       // Remove the transaction from the queue of pending xactions
       _read_queue.erase(it);
       return;
@@ -117,9 +112,6 @@ void SimObj::DRAM::write_complete(unsigned int id, uint64_t address, uint64_t cl
     if(std::get<0>(*it) == address) {
       // Set the complete flag to true
       *(std::get<1>(*it)) = true;
-      if(std::get<2>(*it) == true) {
-        sequential_write_counter = 0;
-      }
       // Remove the transaction from the queue of pending xactions
       _write_queue.erase(it);
       return;
@@ -130,6 +122,17 @@ void SimObj::DRAM::write_complete(unsigned int id, uint64_t address, uint64_t cl
 #endif
 }
 
+uint64_t SimObj::DRAM::get_bytes(void) {
+  return _bytes;
+}
+
 void SimObj::DRAM::print_stats() {
   _mem->printStats(true);
+  Memory::print_stats();
 }
+
+void SimObj::DRAM::clear_stats() {
+  _bytes = 0;
+}
+
+#endif // DRAMSIM2
@@ -2,13 +2,16 @@
  * Andrew Smith
  * 
  * DRAM Memory. Derived from Memory class, Uses DRAMSim2 to model the timing
+ * Only built with -DDRAMSIM2 (make DRAMSIM2=1), which links libdramsim.
  *
  */
 
 #ifndef _DRAM_H
 #define _DRAM_H
+#ifdef DRAMSIM2
 
 #include <list>
+#include <string>
 #include <tuple>
 #include <vector>
 #include "DRAMSim.h"
@@ -26,13 +29,13 @@ private:
 
   DRAMSim::MultiChannelMemorySystem *_mem;
 
-  int sequential_write_counter;
-  int sequential_read_counter;
-  int buffer_size;
+  uint64_t _transaction_size;
+  uint64_t _bytes;
 
 public:
   DRAM(void);
   DRAM(uint64_t access_latency, uint64_t write_latency, uint64_t num_simultaneous_requests);
+  DRAM(const std::string& device_ini, const std::string& system_ini, uint64_t megs);
   ~DRAM();
 
   void tick(void);
@@ -42,9 +45,12 @@ public:
   // DRAMSim2 Callbacks:
   void read_complete(unsigned int id, uint64_t address, uint64_t clock_cycle);
   void write_complete(unsigned int id, uint64_t address, uint64_t clock_cycle);
+  uint64_t get_bytes(void);
   void print_stats();
+  void clear_stats();
 }; // class DRAM
 
 } // namespace SimObj
 
+#endif // DRAMSIM2
 #endif
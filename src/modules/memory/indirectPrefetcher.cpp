@@ -0,0 +1,160 @@
+/*
+ * Andrew Smith
+ *
+ * Indirect Prefetcher
+ *
+ */
+
+#include <cassert>
+#include <string>
+
+#include "indirectPrefetcher.h"
+#include "log.h"
+
+SimObj::IndirectPrefetcher::IndirectPrefetcher(uint64_t num_ports, uint64_t lookahead, uint64_t entries, uint64_t hit_latency) {
+  assert(num_ports != 0);
+  assert(entries != 0);
+  _num_ports = num_ports;
+  _lookahead = lookahead;
+  _entries = entries;
+  _hit_latency = hit_latency;
+  _tick = 0;
+  _next.resize(_num_ports, NULL);
+  _buffer.resize(_num_ports);
+  _issued.resize(_num_ports);
+  _merged.resize(_num_ports);
+  _useful.resize(_num_ports);
+  _late.resize(_num_ports);
+  _misses.resize(_num_ports);
+  _full.resize(_num_ports);
+  clear_stats();
+}
+
+SimObj::IndirectPrefetcher::~IndirectPrefetcher() {
+  for(auto & buffer : _buffer) {
+    for(auto & element : buffer) {
+      delete element.second.fill;
+    }
+  }
+}
+
+void SimObj::IndirectPrefetcher::connect(uint64_t port, Memory* next) {
+  assert(port < _num_ports);
+  assert(next != NULL);
+  _next[port] = next;
+}
+
+uint64_t SimObj::IndirectPrefetcher::get_lookahead(void) {
+  return _lookahead;
+}
+
+bool SimObj::IndirectPrefetcher::prefetch(uint64_t vertex_dst_id, uint64_t addr) {
+  uint64_t port = vertex_dst_id % _num_ports;
+  assert(_next[port] != NULL);
+  auto entry = _buffer[port].find(addr);
+  if(entry != _buffer[port].end()) {
+    entry->second.refs++;
+    _merged[port]++;
+    return true;
+  }
+  if(_buffer[port].size() >= _entries) {
+    _full[port]++;
+    return false;
+  }
+  entry = _buffer[port].emplace(addr, entry_t{new bool(false), 1, {}}).first;
+  _next[port]->read(addr, entry->second.fill, false);
+  _issued[port]++;
+  return true;
+}
+
+bool SimObj::IndirectPrefetcher::lookup(uint64_t port, uint64_t addr, bool* complete) {
+  assert(port < _num_ports);
+  auto entry = _buffer[port].find(addr);
+  if(entry == _buffer[port].end() || entry->second.refs == 0) {
+    _misses[port]++;
+    return false;
+  }
+  entry->second.refs--;
+  if(*entry->second.fill) {
+    _useful[port]++;
+    _hits.push_back(std::make_pair(_tick + _hit_latency, complete));
+    if(entry->second.refs == 0) {
+      delete entry->second.fill;
+      _buffer[port].erase(entry);
+    }
+  }
+  else {
+    // Still in flight, freed by tick once it arrives
+    _late[port]++;
+    entry->second.waiters.push_back(complete);
+  }
+  return true;
+}
+
+void SimObj::IndirectPrefetcher::tick(void) {
+  _tick++;
+  for(auto it = _hits.begin(); it != _hits.end();) {
+    if(it->first <= _tick) {
+      *(it->second) = true;
+      it = _hits.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+  for(auto & buffer : _buffer) {
+    for(auto it = buffer.begin(); it != buffer.end();) {
+      if(*it->second.fill) {
+        for(auto & waiter : it->second.waiters) {
+          *waiter = true;
+        }
+        it->second.waiters.clear();
+        if(it->second.refs == 0) {
+          delete it->second.fill;
+          it = buffer.erase(it);
+          continue;
+        }
+      }
+      it++;
+    }
+  }
+}
+
+void SimObj::IndirectPrefetcher::clear_stats(void) {
+  for(uint64_t port = 0; port < _num_ports; port++) {
+    _issued[port] = 0;
+    _merged[port] = 0;
+    _useful[port] = 0;
+    _late[port] = 0;
+    _misses[port] = 0;
+    _full[port] = 0;
+  }
+}
+
+void SimObj::IndirectPrefetcher::print_stats(void) {
+  sim_out.write("-------------------------------------------------------------------------------\n");
+  sim_out.write("[ IndirectPrefetcher ]\n");
+  for(uint64_t port = 0; port < _num_ports; port++) {
+    sim_out.write("  Port " + std::to_string(port) + ":\n");
+    sim_out.write("    Issued:         " + std::to_string(_issued[port]) + "\n");
+    sim_out.write("    Merged:         " + std::to_string(_merged[port]) + "\n");
+    sim_out.write("    Useful:         " + std::to_string(_useful[port]) + "\n");
+    sim_out.write("    Late:           " + std::to_string(_late[port]) + "\n");
+    sim_out.write("    Misses:         " + std::to_string(_misses[port]) + "\n");
+    sim_out.write("    Buffer Full:    " + std::to_string(_full[port]) + "\n");
+  }
+}
+
+void SimObj::IndirectPrefetcher::print_stats_csv(void) {
+  sim_out.write("IndirectPrefetcher,");
+  std::vector<std::pair<std::string, std::vector<uint64_t>*>> columns = {
+    {"issued", &_issued}, {"merged", &_merged}, {"useful", &_useful},
+    {"late", &_late}, {"misses", &_misses}, {"full", &_full}};
+  for(auto & column : columns) {
+    sim_out.write(column.first + ",");
+    for(auto & element : *column.second) {
+      sim_out.write(std::to_string(element) + ",");
+    }
+  }
+  sim_out.write("\n");
+}
@@ -0,0 +1,72 @@
+/*
+ * Andrew Smith
+ *
+ * Indirect Prefetcher:
+ *  Shared by all pipelines. ReadSrcEdges runs lookahead edges ahead of its
+ *  edge stream, resolves each edge's destination and reads the destination
+ *  property early into the buffer of the port that owns the destination.
+ *  ReadDstProperty looks the property up in its port's buffer before going
+ *  to memory. Ports follow the crossbar routing (destination % ports).
+ *
+ */
+
+#ifndef INDIRECT_PREFETCHER_H
+#define INDIRECT_PREFETCHER_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory.h"
+
+namespace SimObj {
+
+class IndirectPrefetcher {
+private:
+  struct entry_t {
+    bool* fill;
+    uint64_t refs; // Prefetched edges that have not looked it up yet
+    std::vector<bool*> waiters;
+  };
+
+  uint64_t _num_ports;
+  uint64_t _lookahead;
+  uint64_t _entries;
+  uint64_t _hit_latency;
+  uint64_t _tick;
+  std::vector<Memory*> _next;
+  std::vector<std::map<uint64_t, entry_t>> _buffer;
+  std::list<std::pair<uint64_t, bool*>> _hits; // Finish tick, flag
+
+  // Stats
+  std::vector<uint64_t> _issued;
+  std::vector<uint64_t> _merged;
+  std::vector<uint64_t> _useful;
+  std::vector<uint64_t> _late;
+  std::vector<uint64_t> _misses;
+  std::vector<uint64_t> _full;
+
+public:
+  IndirectPrefetcher(uint64_t num_ports, uint64_t lookahead, uint64_t entries, uint64_t hit_latency);
+  ~IndirectPrefetcher();
+
+  void connect(uint64_t port, Memory* next);
+  uint64_t get_lookahead(void);
+
+  // Returns false if the destination's buffer is full, retry later
+  bool prefetch(uint64_t vertex_dst_id, uint64_t addr);
+  // Returns false if addr is not buffered for port, complete is set otherwise
+  bool lookup(uint64_t port, uint64_t addr, bool* complete);
+
+  void tick(void);
+  void clear_stats(void);
+  void print_stats(void);
+  void print_stats_csv(void);
+};
+
+} // namespace SimObj
+
+#endif
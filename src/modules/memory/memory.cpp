@@ -7,8 +7,11 @@
 
 #include <iostream>
 #include <cassert>
+#include <cstdint>
+#include <string>
 
 #include "memory.h"
+#include "log.h"
   
 SimObj::MemRequest::MemRequest() {
   _complete = NULL;
@@ -57,6 +60,11 @@ SimObj::Memory::Memory() {
   _write_latency = 0;
   _num_simultaneous_requests = 1;
   _action.resize(_num_simultaneous_requests);
+  _row_size = 0;
+  _num_banks = 1;
+  _row_hits = 0;
+  _row_misses = 0;
+  _channel = 0;
 }
 
 SimObj::Memory::Memory(uint64_t access_latency, uint64_t write_latency, uint64_t num_simultaneous_requests) {
@@ -66,6 +74,11 @@ SimObj::Memory::Memory(uint64_t access_latency, uint64_t write_latency, uint64_t
   _num_simultaneous_requests = num_simultaneous_requests;
   assert(_num_simultaneous_requests >= 1);
   _action.resize(_num_simultaneous_requests);
+  _row_size = 0;
+  _num_banks = 1;
+  _row_hits = 0;
+  _row_misses = 0;
+  _channel = 0;
 }
 
 SimObj::Memory::~Memory() {
@@ -93,17 +106,64 @@ void SimObj::Memory::tick(void) {
   }
 }
   
+void SimObj::Memory::set_row_buffer(uint64_t row_size, uint64_t num_banks) {
+  assert(num_banks >= 1);
+  _row_size = row_size;
+  _num_banks = num_banks;
+  _open_row.assign(_num_banks, UINT64_MAX);
+}
+
+void SimObj::Memory::set_channel(uint64_t channel) {
+  _channel = channel;
+}
+
+void SimObj::Memory::update_row_stats(uint64_t addr) {
+  if(_row_size == 0) {
+    return;
+  }
+  // Rows are interleaved across the banks
+  uint64_t row = addr / _row_size;
+  uint64_t bank = row % _num_banks;
+  if(_open_row[bank] == row) {
+    _row_hits++;
+  }
+  else {
+    _row_misses++;
+    _open_row[bank] = row;
+  }
+}
+
 void SimObj::Memory::write(uint64_t addr, bool* complete, bool sequential) {
+  update_row_stats(addr);
   SimObj::MemRequest req(complete, _access_latency + _write_latency, MEM_WRITE);
   _req_queue.push(req);
 }
 
 void SimObj::Memory::read(uint64_t addr, bool* complete, bool sequential) {
+  update_row_stats(addr);
   SimObj::MemRequest req(complete, _access_latency, MEM_READ);
   _req_queue.push(req);
 }
 
 void SimObj::Memory::print_stats() {
+  if(_row_size == 0) {
+    return;
+  }
+  uint64_t accesses = _row_hits + _row_misses;
+  sim_out.write("Memory," + std::to_string(_channel) +
+                ",row_hits," + std::to_string(_row_hits) +
+                ",row_misses," + std::to_string(_row_misses) +
+                ",row_hit_rate," + std::to_string(accesses ? (double)_row_hits / (double)accesses : 0.0) + "\n");
+}
+
+uint64_t SimObj::Memory::get_bytes(void) {
+  return 0;
+}
+
+void SimObj::Memory::print_stats_csv() {
 
 }
 
+void SimObj::Memory::clear_stats() {
+
+}
@@ -8,9 +8,9 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 
+#include <cstdint>
 #include <queue>
 #include <vector>
-#include "DRAMSim.h"
 
 namespace SimObj {
 
@@ -46,9 +46,19 @@ protected:
   uint64_t _access_latency;
   uint64_t _write_latency;
   uint64_t _num_simultaneous_requests;
+  uint64_t _channel; // Printed in the stats rows
   std::vector<MemRequest> _action;
   std::queue<MemRequest> _req_queue;
 
+  // Open-row tracking per bank, disabled while _row_size is 0
+  uint64_t _row_size;
+  uint64_t _num_banks;
+  std::vector<uint64_t> _open_row;
+  uint64_t _row_hits;
+  uint64_t _row_misses;
+
+  void update_row_stats(uint64_t addr);
+
 public:
   Memory(void);
   Memory(uint64_t access_latency, uint64_t write_latency, uint64_t num_simultaneous_requests);
@@ -58,6 +68,14 @@ public:
   virtual void write(uint64_t addr, bool* complete, bool sequential=true);
   virtual void read(uint64_t addr, bool* complete, bool sequential=true);
   virtual void print_stats();
+  virtual void print_stats_csv();
+  virtual void clear_stats();
+
+  // Bytes moved since clear_stats, 0 if the transfer size is not modelled
+  virtual uint64_t get_bytes(void);
+
+  void set_row_buffer(uint64_t row_size, uint64_t num_banks);
+  void set_channel(uint64_t channel);
 };
 
 } // namespace SimObj
@@ -0,0 +1,152 @@
+/*
+ * Andrew Smith
+ *
+ * Memory Channels
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include "memoryChannels.h"
+#include "log.h"
+
+SimObj::channel_policy_t SimObj::channel_policy_from_string(const std::string& name) {
+  if(name == "interleave") return CHANNEL_INTERLEAVE;
+  if(name == "owner") return CHANNEL_OWNER;
+  std::cerr << "[ MemoryChannels ] unknown channel policy: " << name << "\n";
+  assert(false);
+  return CHANNEL_INTERLEAVE;
+}
+
+SimObj::ChannelPort::ChannelPort(MemoryChannels* channels, uint64_t port) {
+  assert(channels != NULL);
+  _channels = channels;
+  _port = port;
+}
+
+SimObj::ChannelPort::~ChannelPort() {
+  _channels = NULL;
+}
+
+void SimObj::ChannelPort::write(uint64_t addr, bool* complete, bool sequential) {
+  _channels->request(_port, addr, complete, sequential, MEM_WRITE);
+}
+
+void SimObj::ChannelPort::read(uint64_t addr, bool* complete, bool sequential) {
+  _channels->request(_port, addr, complete, sequential, MEM_READ);
+}
+
+SimObj::MemoryChannels::MemoryChannels(std::vector<Memory*> channels, uint64_t num_ports, channel_policy_t policy, uint64_t interleave,
+                                       uint64_t remote_latency, uint64_t remote_bandwidth, uint64_t line_size, std::function<int64_t(uint64_t)> owner) {
+  assert(!channels.empty());
+  assert(num_ports >= 1);
+  assert(interleave != 0);
+  assert(line_size != 0);
+  for(auto & channel : channels) {
+    assert(channel != NULL);
+  }
+  _channels = channels;
+  for(uint64_t i = 0; i < num_ports; i++) {
+    _ports.push_back(new ChannelPort(this, i));
+  }
+  _links.resize(num_ports);
+  _credit.assign(num_ports, 0);
+  _policy = policy;
+  _interleave = interleave;
+  _remote_latency = remote_latency;
+  // 0: unlimited bandwidth
+  _remote_bandwidth = remote_bandwidth;
+  _line_size = line_size;
+  _owner = owner;
+  _tick = 0;
+  _local_requests.assign(_channels.size(), 0);
+  _remote_requests.assign(_channels.size(), 0);
+  clear_stats();
+}
+
+SimObj::MemoryChannels::~MemoryChannels() {
+  for(auto & port : _ports) {
+    delete port;
+  }
+}
+
+SimObj::Memory* SimObj::MemoryChannels::get_port(uint64_t port) {
+  assert(port < _ports.size());
+  return _ports[port];
+}
+
+uint64_t SimObj::MemoryChannels::get_channel(uint64_t addr) {
+  if(_policy == CHANNEL_OWNER && _owner) {
+    int64_t owner = _owner(addr);
+    if(owner >= 0) {
+      return owner % _channels.size();
+    }
+  }
+  return (addr / _interleave) % _channels.size();
+}
+
+void SimObj::MemoryChannels::request(uint64_t port, uint64_t addr, bool* complete, bool sequential, mem_op_t type) {
+  uint64_t channel = get_channel(addr);
+  if(channel == port % _channels.size()) {
+    _local_requests[channel]++;
+    if(type == MEM_WRITE) {
+      _channels[channel]->write(addr, complete, sequential);
+    }
+    else {
+      _channels[channel]->read(addr, complete, sequential);
+    }
+    return;
+  }
+  _remote_requests[channel]++;
+  _links[port].emplace_back(_tick + _remote_latency, channel, addr, complete, type, sequential);
+}
+
+void SimObj::MemoryChannels::tick(void) {
+  _tick++;
+  _cycles++;
+  for(uint64_t port = 0; port < _links.size(); port++) {
+    std::deque<remote_t>& link = _links[port];
+    if(_remote_bandwidth != 0) {
+      // The link can not save up more than one cycle or one line
+      _credit[port] = std::min(_credit[port] + _remote_bandwidth, std::max(_remote_bandwidth, _line_size));
+    }
+    while(!link.empty() && std::get<0>(link.front()) <= _tick) {
+      if(_remote_bandwidth != 0) {
+        if(_credit[port] < _line_size) {
+          _link_stalls++;
+          break;
+        }
+        _credit[port] -= _line_size;
+      }
+      uint64_t channel = std::get<1>(link.front());
+      if(std::get<4>(link.front()) == MEM_WRITE) {
+        _channels[channel]->write(std::get<2>(link.front()), std::get<3>(link.front()), std::get<5>(link.front()));
+      }
+      else {
+        _channels[channel]->read(std::get<2>(link.front()), std::get<3>(link.front()), std::get<5>(link.front()));
+      }
+      link.pop_front();
+    }
+  }
+}
+
+void SimObj::MemoryChannels::print_stats_csv(void) {
+  for(uint64_t i = 0; i < _channels.size(); i++) {
+    uint64_t bytes = _channels[i]->get_bytes();
+    sim_out.write("MemoryChannel," + std::to_string(i) +
+                  ",local_requests," + std::to_string(_local_requests[i]) +
+                  ",remote_requests," + std::to_string(_remote_requests[i]) +
+                  ",bytes," + std::to_string(bytes) +
+                  ",bytes_per_cycle," + std::to_string(_cycles ? (double)bytes / (double)_cycles : 0.0) + "\n");
+  }
+  sim_out.write("MemoryChannels,remote_link_stalls," + std::to_string(_link_stalls) + "\n");
+}
+
+void SimObj::MemoryChannels::clear_stats(void) {
+  std::fill(_local_requests.begin(), _local_requests.end(), 0);
+  std::fill(_remote_requests.begin(), _remote_requests.end(), 0);
+  _link_stalls = 0;
+  _cycles = 0;
+}
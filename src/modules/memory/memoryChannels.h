@@ -0,0 +1,93 @@
+/*
+ * Andrew Smith
+ *
+ * Memory Channels:
+ *  Splits the address space over several memory instances. Pipeline p is
+ *  local to channel p % channels; requests to any other channel cross a
+ *  per-pipeline remote link that adds latency and has limited bandwidth.
+ *  Addresses are interleaved across channels, or with the owner policy
+ *  vertex properties live in the channel of the pipeline that owns the
+ *  vertex (the one the crossbar routes it to).
+ *
+ */
+
+#ifndef MEMORY_CHANNELS_H
+#define MEMORY_CHANNELS_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "memory.h"
+
+namespace SimObj {
+
+enum channel_policy_t {
+  CHANNEL_INTERLEAVE,
+  CHANNEL_OWNER,
+  CHANNEL_NUM_POLICIES
+};
+
+channel_policy_t channel_policy_from_string(const std::string& name);
+
+class MemoryChannels;
+
+// Memory interface handed to one pipeline
+class ChannelPort : public Memory {
+private:
+  MemoryChannels* _channels;
+  uint64_t _port;
+
+public:
+  ChannelPort(MemoryChannels* channels, uint64_t port);
+  ~ChannelPort();
+
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+};
+
+class MemoryChannels {
+private:
+  // ready tick, channel, addr, complete, type, sequential
+  typedef std::tuple<uint64_t, uint64_t, uint64_t, bool*, mem_op_t, bool> remote_t;
+
+  std::vector<Memory*> _channels;
+  std::vector<ChannelPort*> _ports;
+  std::vector<std::deque<remote_t>> _links;
+  std::vector<uint64_t> _credit;
+  channel_policy_t _policy;
+  uint64_t _interleave;
+  uint64_t _remote_latency;
+  uint64_t _remote_bandwidth;
+  uint64_t _line_size;
+  // Pipeline owning addr, -1 if it is interleaved
+  std::function<int64_t(uint64_t)> _owner;
+  uint64_t _tick;
+
+  // Stats
+  std::vector<uint64_t> _local_requests;
+  std::vector<uint64_t> _remote_requests;
+  uint64_t _link_stalls;
+  uint64_t _cycles;
+
+  uint64_t get_channel(uint64_t addr);
+
+public:
+  MemoryChannels(std::vector<Memory*> channels, uint64_t num_ports, channel_policy_t policy, uint64_t interleave,
+                 uint64_t remote_latency, uint64_t remote_bandwidth, uint64_t line_size, std::function<int64_t(uint64_t)> owner);
+  ~MemoryChannels();
+
+  Memory* get_port(uint64_t port);
+  void request(uint64_t port, uint64_t addr, bool* complete, bool sequential, mem_op_t type);
+  void tick(void);
+
+  void print_stats_csv(void);
+  void clear_stats(void);
+}; // class MemoryChannels
+
+} // namespace SimObj
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * Andrew Smith
+ *
+ * Memory Model
+ *
+ */
+
+#include "memoryModel.h"
+#include "dram.h"
+#include "simpleDram.h"
+#include "bankedDram.h"
+#include "iniReader.h"
+
+SimObj::Memory* SimObj::new_memory(const Utility::Options& opt, uint64_t channel) {
+  Memory* mem = NULL;
+  if(opt.dram_model == "banked") {
+    mem = new BankedDRAM(opt.dram_ini, opt.dram_system_ini, opt.dram_megs);
+  }
+#ifdef DRAMSIM2
+  else if(opt.dram_model == "dramsim2") {
+    mem = new DRAM(opt.dram_ini, opt.dram_system_ini, opt.dram_megs);
+  }
+#endif
+  else {
+    mem = new SimpleDRAM(opt.dram_read_latency, opt.dram_write_latency, opt.dram_num_simultaneous_requests, opt.dram_data_width, opt.dram_bandwidth);
+  }
+  mem->set_row_buffer(opt.dram_row_size, opt.dram_banks);
+  mem->set_channel(channel);
+  return mem;
+}
+
+uint64_t SimObj::dram_clock_khz(const Utility::Options& opt) {
+  if(opt.dram_clock != 0) {
+    return opt.dram_clock * 1000;
+  }
+  if(opt.dram_model == "simple") {
+    return opt.pipeline_clock * 1000;
+  }
+  return (uint64_t)(1e6 / Utility::IniReader(opt.dram_ini).get_double("tCK", 1.0) + 0.5);
+}
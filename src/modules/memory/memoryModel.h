@@ -0,0 +1,28 @@
+/*
+ * Andrew Smith
+ *
+ * Memory Model:
+ *  Builds the DRAM model selected by the options, shared by g_sim and the
+ *  trace replay tool so both simulate the same memory.
+ *
+ */
+
+#ifndef MEMORY_MODEL_H
+#define MEMORY_MODEL_H
+
+#include <cstdint>
+
+#include "memory.h"
+#include "option.h"
+
+namespace SimObj {
+
+// --dram_model with its row buffer tracking set up, for memory channel channel
+Memory* new_memory(const Utility::Options& opt, uint64_t channel=0);
+
+// DRAM clock in kHz, kHz keeps the tCK fraction
+uint64_t dram_clock_khz(const Utility::Options& opt);
+
+} // namespace SimObj
+
+#endif
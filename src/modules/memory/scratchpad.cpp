@@ -0,0 +1,116 @@
+/*
+ * Andrew Smith
+ *
+ * Scratchpad Memory. Derived from Memory class.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "scratchpad.h"
+#include "log.h"
+
+SimObj::bank_hash_t SimObj::bank_hash_from_string(const std::string& name) {
+  if(name == "mod") return BANK_HASH_MOD;
+  if(name == "xor") return BANK_HASH_XOR;
+  std::cerr << "[ Scratchpad ] unknown bank hash: " << name << "\n";
+  assert(false);
+  return BANK_HASH_MOD;
+}
+
+SimObj::Scratchpad::Scratchpad(uint64_t read_latency, uint64_t write_latency, uint64_t num_banks, uint64_t ports, uint64_t data_width, bank_hash_t hash) : Memory(read_latency, write_latency, 1) {
+  assert(num_banks >= 1);
+  assert(ports >= 1);
+  assert(data_width != 0);
+  _num_banks = num_banks;
+  _ports = ports;
+  _data_width = data_width;
+  _hash = hash;
+  _banks.resize(_num_banks);
+  _name = "Scratchpad";
+  clear_stats();
+}
+
+SimObj::Scratchpad::~Scratchpad() {
+  // Do Nothing
+}
+
+uint64_t SimObj::Scratchpad::get_bank(uint64_t addr) const {
+  uint64_t word = addr / _data_width;
+  if(_hash == BANK_HASH_XOR) {
+    word ^= (word / _num_banks) ^ (word / (_num_banks * _num_banks));
+  }
+  return word % _num_banks;
+}
+
+void SimObj::Scratchpad::enqueue(uint64_t addr, bool* complete, mem_op_t type) {
+  auto & bank = _banks[get_bank(addr)];
+  bank.emplace_back(complete, type, _tick);
+  _max_bank_queue = std::max<uint64_t>(_max_bank_queue, bank.size());
+}
+
+void SimObj::Scratchpad::tick(void) {
+  _tick++;
+  for(auto & bank : _banks) {
+    for(uint64_t port = 0; port < _ports && !bank.empty(); port++) {
+      uint64_t latency = (std::get<1>(bank.front()) == MEM_WRITE) ? _write_latency : _access_latency;
+      _in_flight.emplace_back(_tick + latency, std::get<0>(bank.front()));
+      bank.pop_front();
+    }
+    // Everything left lost its bank this cycle
+    _conflict_stalls += bank.size();
+  }
+  for(auto it = _in_flight.begin(); it != _in_flight.end();) {
+    if(std::get<0>(*it) <= _tick) {
+      *std::get<1>(*it) = true;
+      it = _in_flight.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+}
+
+void SimObj::Scratchpad::write(uint64_t addr, bool* complete, bool sequential) {
+  _writes++;
+  enqueue(addr, complete, MEM_WRITE);
+}
+
+void SimObj::Scratchpad::read(uint64_t addr, bool* complete, bool sequential) {
+  _reads++;
+  enqueue(addr, complete, MEM_READ);
+}
+
+void SimObj::Scratchpad::print_stats() {
+  uint64_t accesses = _reads + _writes;
+  sim_out.write("-------------------------------------------------------------------------------\n");
+  sim_out.write("[ " + _name + " ]\n");
+  sim_out.write("  Reads:            " + std::to_string(_reads) + "\n");
+  sim_out.write("  Writes:           " + std::to_string(_writes) + "\n");
+  sim_out.write("  Conflict Stalls:  " + std::to_string(_conflict_stalls) + " cycles\n");
+  sim_out.write("  Stalls/Access:    " + std::to_string(accesses ? (double)_conflict_stalls / (double)accesses : 0.0) + "\n");
+  sim_out.write("  Max Bank Queue:   " + std::to_string(_max_bank_queue) + "\n");
+}
+
+void SimObj::Scratchpad::print_stats_csv() {
+  uint64_t accesses = _reads + _writes;
+  sim_out.write(_name + ",reads," + std::to_string(_reads) +
+                ",writes," + std::to_string(_writes) +
+                ",conflict_stalls," + std::to_string(_conflict_stalls) +
+                ",stalls_per_access," + std::to_string(accesses ? (double)_conflict_stalls / (double)accesses : 0.0) +
+                ",max_bank_queue," + std::to_string(_max_bank_queue) + "\n");
+}
+
+void SimObj::Scratchpad::clear_stats() {
+  _reads = 0;
+  _writes = 0;
+  _conflict_stalls = 0;
+  _max_bank_queue = 0;
+}
+
+void SimObj::Scratchpad::set_name(std::string name) {
+  _name = name;
+}
@@ -0,0 +1,70 @@
+/*
+ * Andrew Smith
+ *
+ * Scratchpad Memory. Derived from Memory class, an on-chip SRAM split into
+ * banks of data_width-byte words. An address hashes to one bank and each
+ * bank serves up to ports requests a cycle; the rest wait in the bank's
+ * queue and are counted as conflict stalls.
+ *
+ */
+
+#ifndef SCRATCHPAD_H
+#define SCRATCHPAD_H
+
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "memory.h"
+
+namespace SimObj {
+
+enum bank_hash_t {
+  BANK_HASH_MOD,  // Consecutive words in consecutive banks
+  BANK_HASH_XOR,  // Folds the upper word bits in to break up strides
+  BANK_HASH_NUM
+};
+
+bank_hash_t bank_hash_from_string(const std::string& name);
+
+class Scratchpad : public Memory {
+private:
+  // complete, type, tick queued
+  std::vector<std::deque<std::tuple<bool*, mem_op_t, uint64_t>>> _banks;
+  // finish tick, complete
+  std::list<std::tuple<uint64_t, bool*>> _in_flight;
+
+  uint64_t _num_banks;
+  uint64_t _ports;
+  uint64_t _data_width;
+  bank_hash_t _hash;
+  std::string _name;
+
+  // Stats
+  uint64_t _reads;
+  uint64_t _writes;
+  uint64_t _conflict_stalls;
+  uint64_t _max_bank_queue;
+
+  uint64_t get_bank(uint64_t addr) const;
+  void enqueue(uint64_t addr, bool* complete, mem_op_t type);
+
+public:
+  Scratchpad(uint64_t read_latency, uint64_t write_latency, uint64_t num_banks, uint64_t ports, uint64_t data_width, bank_hash_t hash);
+  ~Scratchpad();
+
+  void tick(void);
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+  void print_stats();
+  void print_stats_csv();
+  void clear_stats();
+  void set_name(std::string name);
+}; // class Scratchpad
+
+} // namespace SimObj
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Andrew Smith
+ *
+ * Simple DRAM. Derived from Memory class.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "simpleDram.h"
+#include "log.h"
+
+SimObj::SimpleDRAM::SimpleDRAM(uint64_t read_latency, uint64_t write_latency, uint64_t num_simultaneous_requests, uint64_t data_width, uint64_t bytes_per_cycle) : Memory(read_latency, write_latency, num_simultaneous_requests) {
+  assert(data_width != 0);
+  _data_width = data_width;
+  // 0: unlimited bandwidth
+  _bytes_per_cycle = bytes_per_cycle;
+  _credit = 0;
+  clear_stats();
+}
+
+SimObj::SimpleDRAM::~SimpleDRAM() {
+  // Do Nothing
+}
+
+void SimObj::SimpleDRAM::issue(void) {
+  if(_bytes_per_cycle != 0) {
+    // The bus can not save up more than one cycle or one transfer
+    _credit = std::min(_credit + _bytes_per_cycle, std::max(_bytes_per_cycle, _data_width));
+  }
+  bool busy = false;
+  while(!_queue.empty() && _in_flight.size() < _num_simultaneous_requests) {
+    if(_bytes_per_cycle != 0) {
+      if(_credit < _data_width) {
+        break;
+      }
+      _credit -= _data_width;
+    }
+    uint64_t addr;
+    bool* complete;
+    mem_op_t type;
+    uint64_t queued;
+    std::tie(addr, complete, type, queued) = _queue.front();
+    _queue.pop();
+    // Requests queued this cycle issue no earlier than the next
+    uint64_t delay = _tick - queued - 1;
+    _queue_delay += delay;
+    _max_queue_delay = std::max(_max_queue_delay, delay);
+    // Writes pay the write latency on top of the access, as in Memory::write
+    uint64_t latency = (type == MEM_WRITE) ? _access_latency + _write_latency : _access_latency;
+    _in_flight.emplace_back(_tick + latency, complete);
+    busy = true;
+  }
+  if(busy) {
+    _busy_cycles++;
+  }
+}
+
+void SimObj::SimpleDRAM::tick(void) {
+  _tick++;
+  _cycles++;
+  issue();
+  for(auto it = _in_flight.begin(); it != _in_flight.end();) {
+    if(std::get<0>(*it) <= _tick) {
+      *std::get<1>(*it) = true;
+      it = _in_flight.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+}
+
+void SimObj::SimpleDRAM::write(uint64_t addr, bool* complete, bool sequential) {
+  update_row_stats(addr);
+  _writes++;
+  _queue.emplace(addr, complete, MEM_WRITE, _tick);
+}
+
+void SimObj::SimpleDRAM::read(uint64_t addr, bool* complete, bool sequential) {
+  update_row_stats(addr);
+  _reads++;
+  _queue.emplace(addr, complete, MEM_READ, _tick);
+}
+
+uint64_t SimObj::SimpleDRAM::get_bytes(void) {
+  return (_reads + _writes) * _data_width;
+}
+
+void SimObj::SimpleDRAM::print_stats() {
+  Memory::print_stats();
+}
+
+void SimObj::SimpleDRAM::print_stats_csv() {
+  uint64_t requests = _reads + _writes;
+  uint64_t bytes = get_bytes();
+  sim_out.write("SimpleDRAM," + std::to_string(_channel) +
+                ",reads," + std::to_string(_reads) +
+                ",writes," + std::to_string(_writes) +
+                ",bytes," + std::to_string(bytes) +
+                ",bytes_per_cycle," + std::to_string(_cycles ? (double)bytes / (double)_cycles : 0.0) +
+                ",bus_utilization," + std::to_string(_cycles ? (double)_busy_cycles / (double)_cycles : 0.0) +
+                ",avg_queue_delay," + std::to_string(requests ? (double)_queue_delay / (double)requests : 0.0) +
+                ",max_queue_delay," + std::to_string(_max_queue_delay) + "\n");
+}
+
+void SimObj::SimpleDRAM::clear_stats() {
+  _reads = 0;
+  _writes = 0;
+  _queue_delay = 0;
+  _max_queue_delay = 0;
+  _busy_cycles = 0;
+  _cycles = 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Andrew Smith
+ *
+ * Simple DRAM. Derived from Memory class, a first-order bandwidth-limited
+ * model used when DRAMSim2 is not available. Every request moves one
+ * data-width transfer over a bus of fixed bytes per cycle, then waits the
+ * read latency, plus the write latency for writes. Requests queue while the
+ * bus is busy or the maximum number of requests are in flight.
+ *
+ */
+
+#ifndef SIMPLE_DRAM_H
+#define SIMPLE_DRAM_H
+
+#include <cstdint>
+#include <list>
+#include <queue>
+#include <tuple>
+
+#include "memory.h"
+
+namespace SimObj {
+
+class SimpleDRAM : public Memory {
+private:
+  // addr, complete, type, tick queued
+  std::queue<std::tuple<uint64_t, bool*, mem_op_t, uint64_t>> _queue;
+  // finish tick, complete
+  std::list<std::tuple<uint64_t, bool*>> _in_flight;
+
+  uint64_t _data_width;
+  uint64_t _bytes_per_cycle;
+  uint64_t _credit;
+
+  // Stats
+  uint64_t _reads;
+  uint64_t _writes;
+  uint64_t _queue_delay;
+  uint64_t _max_queue_delay;
+  uint64_t _busy_cycles;
+  uint64_t _cycles;
+
+  void issue(void);
+
+public:
+  SimpleDRAM(uint64_t read_latency, uint64_t write_latency, uint64_t num_simultaneous_requests, uint64_t data_width, uint64_t bytes_per_cycle);
+  ~SimpleDRAM();
+
+  void tick(void);
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+  uint64_t get_bytes(void);
+  void print_stats();
+  void print_stats_csv();
+  void clear_stats();
+}; // class SimpleDRAM
+
+} // namespace SimObj
+
+#endif
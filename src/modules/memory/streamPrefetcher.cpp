@@ -0,0 +1,215 @@
+/*
+ * Andrew Smith
+ *
+ * Stream Prefetcher. Derived from Memory class.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "streamPrefetcher.h"
+#include "log.h"
+
+SimObj::StreamPrefetcher::StreamPrefetcher(Memory* next, uint64_t num_streams, uint64_t depth, uint64_t line_size, uint64_t hit_latency) {
+  assert(next != NULL);
+  assert(num_streams != 0);
+  assert(depth != 0);
+  assert(line_size != 0);
+  _next = next;
+  _depth = depth;
+  _line_size = line_size;
+  _hit_latency = hit_latency;
+  _streams.resize(num_streams);
+  for(auto & stream : _streams) {
+    stream.valid = false;
+    stream.trained = false;
+    stream.last_line = 0;
+    stream.next_prefetch = 0;
+    stream.last_use = 0;
+  }
+  _name = "StreamPrefetcher";
+  clear_stats();
+}
+
+SimObj::StreamPrefetcher::~StreamPrefetcher() {
+  for(auto & stream : _streams) {
+    for(auto & element : stream.buffer) {
+      delete element.second.fill;
+    }
+  }
+  for(auto & fill : _orphans) {
+    delete fill;
+  }
+  _next = NULL;
+}
+
+void SimObj::StreamPrefetcher::drop(prefetch_t& entry) {
+  if(!entry.used) {
+    _useless++;
+  }
+  if(*entry.fill) {
+    delete entry.fill;
+  }
+  else {
+    _orphans.push_back(entry.fill);
+  }
+  entry.fill = NULL;
+}
+
+void SimObj::StreamPrefetcher::drop_below(stream_t& stream, uint64_t line) {
+  while(!stream.buffer.empty() && stream.buffer.begin()->first < line && stream.buffer.begin()->second.waiters.empty()) {
+    drop(stream.buffer.begin()->second);
+    stream.buffer.erase(stream.buffer.begin());
+  }
+}
+
+void SimObj::StreamPrefetcher::advance(stream_t& stream, uint64_t line) {
+  stream.last_line = line;
+  stream.last_use = _tick;
+  drop_below(stream, line);
+  if(!stream.trained) {
+    return;
+  }
+  stream.next_prefetch = std::max(stream.next_prefetch, line + 1);
+  while(stream.next_prefetch <= line + _depth) {
+    prefetch_t entry = {new bool(false), false, {}};
+    _next->read(stream.next_prefetch * _line_size, entry.fill);
+    stream.buffer.emplace(stream.next_prefetch, entry);
+    stream.next_prefetch++;
+    _issued++;
+  }
+}
+
+void SimObj::StreamPrefetcher::tick(void) {
+  _tick++;
+  for(auto it = _hits.begin(); it != _hits.end();) {
+    if(it->first <= _tick) {
+      *(it->second) = true;
+      it = _hits.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+  // Wake up reads that were waiting on a prefetch in flight
+  for(auto & stream : _streams) {
+    for(auto & element : stream.buffer) {
+      if(*element.second.fill && !element.second.waiters.empty()) {
+        for(auto & waiter : element.second.waiters) {
+          *waiter = true;
+        }
+        element.second.waiters.clear();
+      }
+    }
+  }
+  for(auto it = _orphans.begin(); it != _orphans.end();) {
+    if(**it) {
+      delete *it;
+      it = _orphans.erase(it);
+    }
+    else {
+      it++;
+    }
+  }
+}
+
+void SimObj::StreamPrefetcher::read(uint64_t addr, bool* complete, bool sequential) {
+  if(!sequential) {
+    _next->read(addr, complete, sequential);
+    return;
+  }
+  uint64_t line = addr / _line_size;
+  // Covered by a stream buffer?
+  for(auto & stream : _streams) {
+    auto entry = stream.buffer.find(line);
+    if(stream.valid && entry != stream.buffer.end()) {
+      if(*entry->second.fill) {
+        if(!entry->second.used) _useful++;
+        _hits.push_back(std::make_pair(_tick + _hit_latency, complete));
+      }
+      else {
+        if(!entry->second.used) _late++;
+        entry->second.waiters.push_back(complete);
+      }
+      entry->second.used = true;
+      advance(stream, line);
+      return;
+    }
+  }
+  _demand++;
+  _next->read(addr, complete, sequential);
+  // Continues a stream?
+  for(auto & stream : _streams) {
+    if(stream.valid && (line == stream.last_line || line == stream.last_line + 1)) {
+      stream.trained |= (line == stream.last_line + 1);
+      advance(stream, line);
+      return;
+    }
+  }
+  // Start a new stream in place of the least recently used one
+  stream_t* victim = &_streams[0];
+  for(auto & stream : _streams) {
+    if(!stream.valid) {
+      victim = &stream;
+      break;
+    }
+    if(stream.last_use < victim->last_use) {
+      victim = &stream;
+    }
+  }
+  drop_below(*victim, UINT64_MAX);
+  if(!victim->buffer.empty()) {
+    // Reads still waiting on the old stream, keep it
+    return;
+  }
+  victim->valid = true;
+  victim->trained = false;
+  victim->next_prefetch = line + 1;
+  advance(*victim, line);
+}
+
+void SimObj::StreamPrefetcher::write(uint64_t addr, bool* complete, bool sequential) {
+  // Buffered copies of the line are stale now
+  uint64_t line = addr / _line_size;
+  for(auto & stream : _streams) {
+    auto entry = stream.buffer.find(line);
+    if(entry != stream.buffer.end() && entry->second.waiters.empty()) {
+      drop(entry->second);
+      stream.buffer.erase(entry);
+    }
+  }
+  _next->write(addr, complete, sequential);
+}
+
+void SimObj::StreamPrefetcher::set_name(std::string name) {
+  _name = name;
+}
+
+void SimObj::StreamPrefetcher::print_stats() {
+  sim_out.write("-------------------------------------------------------------------------------\n");
+  sim_out.write("[ " + _name + " ]\n");
+  sim_out.write("  Issued:           " + std::to_string(_issued) + "\n");
+  sim_out.write("  Useful:           " + std::to_string(_useful) + "\n");
+  sim_out.write("  Late:             " + std::to_string(_late) + "\n");
+  sim_out.write("  Useless:          " + std::to_string(_useless) + "\n");
+  sim_out.write("  Demand Reads:     " + std::to_string(_demand) + "\n");
+}
+
+void SimObj::StreamPrefetcher::print_stats_csv() {
+  sim_out.write(_name + ","
+    + std::to_string(_issued) + ","
+    + std::to_string(_useful) + ","
+    + std::to_string(_late) + ","
+    + std::to_string(_useless) + ","
+    + std::to_string(_demand) + "\n");
+}
+
+void SimObj::StreamPrefetcher::clear_stats() {
+  _issued = 0;
+  _useful = 0;
+  _late = 0;
+  _useless = 0;
+  _demand = 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Andrew Smith
+ *
+ * Stream Prefetcher. Derived from Memory class, sits in front of another
+ * Memory and detects ascending streams of sequential reads. Once a stream
+ * has seen two consecutive lines it fetches up to depth lines ahead into a
+ * per-stream buffer. Reads flagged non-sequential bypass the prefetcher.
+ *
+ */
+
+#ifndef STREAM_PREFETCHER_H
+#define STREAM_PREFETCHER_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory.h"
+
+namespace SimObj {
+
+class StreamPrefetcher : public Memory {
+private:
+  struct prefetch_t {
+    bool* fill; // Owned, outlives the entry if the fill is still in flight
+    bool used;
+    std::vector<bool*> waiters;
+  };
+
+  struct stream_t {
+    bool valid;
+    bool trained;
+    uint64_t last_line;
+    uint64_t next_prefetch;
+    uint64_t last_use;
+    std::map<uint64_t, prefetch_t> buffer;
+  };
+
+  Memory* _next;
+  std::string _name;
+  uint64_t _depth;
+  uint64_t _line_size;
+  uint64_t _hit_latency;
+  std::vector<stream_t> _streams;
+  std::list<std::pair<uint64_t, bool*>> _hits; // Finish tick, flag
+  std::list<bool*> _orphans; // Fills of dropped entries still in flight
+
+  // Stats
+  uint64_t _issued;
+  uint64_t _useful;   // Data was in the buffer when first read
+  uint64_t _late;     // First read arrived while the prefetch was in flight
+  uint64_t _useless;  // Dropped without being read
+  uint64_t _demand;   // Sequential reads the prefetcher did not cover
+
+  void drop(prefetch_t& entry);
+  void drop_below(stream_t& stream, uint64_t line);
+  void advance(stream_t& stream, uint64_t line);
+
+public:
+  StreamPrefetcher(Memory* next, uint64_t num_streams, uint64_t depth, uint64_t line_size, uint64_t hit_latency);
+  ~StreamPrefetcher();
+
+  void tick(void);
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+  void print_stats();
+  void print_stats_csv();
+  void clear_stats();
+  void set_name(std::string name);
+}; // class StreamPrefetcher
+
+} // namespace SimObj
+
+#endif
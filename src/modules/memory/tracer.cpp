@@ -0,0 +1,33 @@
+/*
+ * Andrew Smith
+ *
+ * Tracer. Derived from Memory class.
+ *
+ */
+
+#include <cassert>
+
+#include "tracer.h"
+
+SimObj::Tracer::Tracer(Memory* next, Utility::TraceWriter* trace, const std::string& source) {
+  assert(next != NULL);
+  assert(trace != NULL);
+  _next = next;
+  _trace = trace;
+  _source = _trace->add_source(source);
+}
+
+SimObj::Tracer::~Tracer() {
+  _next = NULL;
+  _trace = NULL;
+}
+
+void SimObj::Tracer::write(uint64_t addr, bool* complete, bool sequential) {
+  _trace->record(_source, true, sequential, addr);
+  _next->write(addr, complete, sequential);
+}
+
+void SimObj::Tracer::read(uint64_t addr, bool* complete, bool sequential) {
+  _trace->record(_source, false, sequential, addr);
+  _next->read(addr, complete, sequential);
+}
@@ -0,0 +1,36 @@
+/*
+ * Andrew Smith
+ *
+ * Tracer. Derived from Memory class, records every request that passes
+ * through it in a memory trace under its source name, then forwards it.
+ *
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <cstdint>
+#include <string>
+
+#include "memory.h"
+#include "trace.h"
+
+namespace SimObj {
+
+class Tracer : public Memory {
+private:
+  Memory* _next;
+  Utility::TraceWriter* _trace;
+  uint64_t _source;
+
+public:
+  Tracer(Memory* next, Utility::TraceWriter* trace, const std::string& source);
+  ~Tracer();
+
+  void write(uint64_t addr, bool* complete, bool sequential=true);
+  void read(uint64_t addr, bool* complete, bool sequential=true);
+}; // class Tracer
+
+} // namespace SimObj
+
+#endif
@@ -55,12 +55,12 @@ public:
   virtual ~Module();
 
   virtual stall_t is_stalled(void);
-  virtual stall_t is_stalled(Utility::pipeline_data<v_t, e_t> data);
+  virtual stall_t is_stalled(const Utility::pipeline_data<v_t, e_t>& data);
   virtual void tick(void);
   virtual void receive_message(msg_t msg);
   uint64_t get_attr(void); 
   virtual void ready(void);
-  virtual void ready(Utility::pipeline_data<v_t, e_t> data);
+  virtual void ready(const Utility::pipeline_data<v_t, e_t>& data);
   void set_next(Module* next);
   void set_prev(Module* prev);
   virtual void update_stats();
@@ -30,7 +30,7 @@ SimObj::stall_t SimObj::Module<v_t, e_t>::is_stalled(void) {
 }
 
 template<class v_t, class e_t>
-SimObj::stall_t SimObj::Module<v_t, e_t>::is_stalled(Utility::pipeline_data<v_t, e_t> data) {
+SimObj::stall_t SimObj::Module<v_t, e_t>::is_stalled(const Utility::pipeline_data<v_t, e_t>& data) {
   return _stall;
 }
 
@@ -58,7 +58,7 @@ void SimObj::Module<v_t, e_t>::ready(void) {
 }
 
 template<class v_t, class e_t>
-void SimObj::Module<v_t, e_t>::ready(Utility::pipeline_data<v_t, e_t> data) {
+void SimObj::Module<v_t, e_t>::ready(const Utility::pipeline_data<v_t, e_t>& data) {
   // Does Nothing
   _data = data;
   _ready = true;
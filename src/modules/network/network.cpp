@@ -2,7 +2,124 @@
  *
  * Andrew Smith
  *
- * Network Base Class Implementation
+ * Network On Chip
+ *  Topologies and dimension-order routing.
  */
 
+#include <cassert>
+#include <cmath>
+#include <iostream>
 
+#include "network.h"
+
+NoC::topology_t NoC::topology_from_string(const std::string& name) {
+  if(name == "mesh") return TOPO_MESH;
+  if(name == "torus") return TOPO_TORUS;
+  if(name == "ring") return TOPO_RING;
+  std::cerr << "[ Network ] unknown topology: " << name << "\n";
+  assert(false);
+  return TOPO_MESH;
+}
+
+std::string NoC::topology_to_string(topology_t type) {
+  switch(type) {
+    case TOPO_MESH: return "mesh";
+    case TOPO_TORUS: return "torus";
+    case TOPO_RING: return "ring";
+    default: return "unknown";
+  }
+}
+
+NoC::port_t NoC::opposite(port_t port) {
+  switch(port) {
+    case PORT_EAST: return PORT_WEST;
+    case PORT_WEST: return PORT_EAST;
+    case PORT_NORTH: return PORT_SOUTH;
+    case PORT_SOUTH: return PORT_NORTH;
+    default: return PORT_LOCAL;
+  }
+}
+
+NoC::Topology::Topology(topology_t type, uint64_t nodes, uint64_t width) {
+  assert(type < TOPO_NUM_TYPES);
+  assert(nodes > 0);
+  _type = type;
+  _nodes = nodes;
+  if(type == TOPO_RING) {
+    width = nodes;
+  }
+  else if(width == 0) {
+    // Largest divisor not above the square root
+    width = (uint64_t)std::sqrt((double)nodes);
+    while(nodes % width != 0) {
+      width--;
+    }
+  }
+  assert(nodes % width == 0);
+  _width = width;
+  _height = nodes / width;
+}
+
+int64_t NoC::Topology::distance(uint64_t a, uint64_t b, uint64_t n) const {
+  int64_t steps = (int64_t)b - (int64_t)a;
+  if(wraps()) {
+    // Shortest way round, ties go east/south
+    uint64_t forward = (b + n - a) % n;
+    steps = forward <= n - forward ? (int64_t)forward : -(int64_t)(n - forward);
+  }
+  return steps;
+}
+
+bool NoC::Topology::has_link(uint64_t node, port_t port) const {
+  assert(node < _nodes);
+  uint64_t x = node % _width;
+  uint64_t y = node / _width;
+  switch(port) {
+    case PORT_EAST: return wraps() ? _width > 1 : x + 1 < _width;
+    case PORT_WEST: return wraps() ? _width > 1 : x > 0;
+    case PORT_NORTH: return wraps() ? _height > 1 : y > 0;
+    case PORT_SOUTH: return wraps() ? _height > 1 : y + 1 < _height;
+    default: return false;
+  }
+}
+
+uint64_t NoC::Topology::neighbor(uint64_t node, port_t port) const {
+  assert(has_link(node, port));
+  uint64_t x = node % _width;
+  uint64_t y = node / _width;
+  switch(port) {
+    case PORT_EAST: x = (x + 1) % _width; break;
+    case PORT_WEST: x = (x + _width - 1) % _width; break;
+    case PORT_NORTH: y = (y + _height - 1) % _height; break;
+    case PORT_SOUTH: y = (y + 1) % _height; break;
+    default: break;
+  }
+  return y * _width + x;
+}
+
+uint64_t NoC::Topology::num_links(void) const {
+  uint64_t links = 0;
+  for(uint64_t node = 0; node < _nodes; node++) {
+    for(int port = PORT_EAST; port < PORT_NUM; port++) {
+      links += has_link(node, (port_t)port);
+    }
+  }
+  return links;
+}
+
+NoC::port_t NoC::Topology::route(uint64_t node, uint64_t dst) const {
+  assert(node < _nodes && dst < _nodes);
+  int64_t dx = distance(node % _width, dst % _width, _width);
+  if(dx != 0) {
+    return dx > 0 ? PORT_EAST : PORT_WEST;
+  }
+  int64_t dy = distance(node / _width, dst / _width, _height);
+  if(dy != 0) {
+    return dy > 0 ? PORT_SOUTH : PORT_NORTH;
+  }
+  return PORT_LOCAL;
+}
+
+uint64_t NoC::Topology::hops(uint64_t src, uint64_t dst) const {
+  return std::abs(distance(src % _width, dst % _width, _width)) + std::abs(distance(src / _width, dst / _width, _height));
+}
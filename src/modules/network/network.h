@@ -2,16 +2,159 @@
  *
  * Andrew Smith
  *
- * Network Base Class Implementation
+ * Network On Chip
+ *  Packet switched interconnect between the pipelines, a drop-in for the
+ *  Crossbar. Every pipeline sits on a router of a 2D mesh, a 2D torus or a
+ *  ring and edges travel to the router of their destination pipeline with
+ *  dimension-order (XY) routing.
+ *
+ *  Routers have an input buffer per port and forward one packet per output
+ *  port each cycle, choosing between inputs round-robin. A hop takes
+ *  hop_latency cycles. Senders hold a credit per free slot of the buffer
+ *  at the other end of each link and the credit comes back hop_latency
+ *  cycles after the packet leaves that buffer. The wrap-around links of the
+ *  torus and ring could deadlock, so a packet entering one of their rings
+ *  needs two credits, leaving a free slot for the packets already in it
+ *  (bubble flow control).
+ *
  */
 
 #ifndef NETWORK_H 
 #define NETWORK_H 
 
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "interconnect.h"
+#include "ringBuffer.h"
+
 namespace NoC {
 
+enum topology_t {
+  TOPO_MESH,
+  TOPO_TORUS,
+  TOPO_RING,
+  TOPO_NUM_TYPES
+};
+
+topology_t topology_from_string(const std::string& name);
+std::string topology_to_string(topology_t type);
+
+// Router ports, north decreases y and south increases it
+enum port_t {
+  PORT_LOCAL,
+  PORT_EAST,
+  PORT_WEST,
+  PORT_NORTH,
+  PORT_SOUTH,
+  PORT_NUM
+};
+
+port_t opposite(port_t port);
+
+// Places nodes on a width x height grid, node = y * width + x
+class Topology {
+private:
+  topology_t _type;
+  uint64_t _nodes;
+  uint64_t _width;
+  uint64_t _height;
+
+  // Signed steps from a to b along a dimension of size n
+  int64_t distance(uint64_t a, uint64_t b, uint64_t n) const;
+
+public:
+  // width 0 picks the squarest grid, a ring is always nodes x 1
+  Topology(topology_t type, uint64_t nodes, uint64_t width);
+
+  topology_t get_type(void) const { return _type; }
+  uint64_t get_nodes(void) const { return _nodes; }
+  uint64_t get_width(void) const { return _width; }
+  uint64_t get_height(void) const { return _height; }
+  // Dimensions close into rings
+  bool wraps(void) const { return _type != TOPO_MESH; }
 
+  bool has_link(uint64_t node, port_t port) const;
+  uint64_t neighbor(uint64_t node, port_t port) const;
+  uint64_t num_links(void) const;
+  // Output port towards dst, X first then Y, PORT_LOCAL once there
+  port_t route(uint64_t node, uint64_t dst) const;
+  uint64_t hops(uint64_t src, uint64_t dst) const;
+};
+
+template<class v_t, class e_t>
+class Network : public SimObj::Interconnect<v_t, e_t> {
+private:
+  struct packet_t {
+    Utility::pipeline_data<v_t, e_t> data;
+    uint64_t injected; // Tick the packet entered the network
+  };
+
+  // Packet on a link, arriving at the input port of node
+  struct transfer_t {
+    packet_t packet;
+    uint64_t arrive;
+    uint64_t node;
+    port_t port;
+  };
+
+  // Credit on its way back to the output port of node
+  struct credit_t {
+    uint64_t arrive;
+    uint64_t node;
+    port_t port;
+  };
+
+  using SimObj::Module<v_t, e_t>::_tick;
+  using SimObj::Interconnect<v_t, e_t>::_num_ports;
+  using SimObj::Interconnect<v_t, e_t>::_out_module;
+  using SimObj::Interconnect<v_t, e_t>::route;
+
+  Topology _topology;
+  uint64_t _hop_latency;
+  uint64_t _buffer_depth;
+  std::vector<std::vector<Utility::RingBuffer<packet_t>*>> _buffers; // [node][input port]
+  std::vector<std::vector<uint64_t>> _credits; // [node][output port]
+  std::vector<std::vector<uint64_t>> _rr_next; // [node][output port]
+  std::vector<bool> _input_sent; // [input port] of the router being ticked
+  std::deque<transfer_t> _links;
+  std::deque<credit_t> _credit_returns;
+
+  // A packet turning into a new dimension of a torus or ring
+  bool entering_ring(port_t in, port_t out) const;
+  // Move the head of input buffer in through out, false if out cannot take it
+  bool send(uint64_t node, port_t in, port_t out);
+
+  // Stats
+  using SimObj::Module<v_t, e_t>::_items_processed;
+  using SimObj::Module<v_t, e_t>::_name;
+  std::vector<uint64_t> _input_items;
+  std::vector<uint64_t> _output_items;
+  std::vector<std::vector<uint64_t>> _link_items; // [node][output port]
+  uint64_t _cycles;
+  uint64_t _total_latency;
+  uint64_t _total_hops;
+  uint64_t _credit_stalls; // Cycles a buffer head waited for credits
+  uint64_t _bubble_stalls; // Of those, waits for the second credit to enter a ring
+
+public:
+  Network(const Topology& topology, uint64_t hop_latency, uint64_t buffer_depth);
+  ~Network();
+
+  SimObj::stall_t is_stalled(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data);
+  void ready(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data);
+  bool busy();
+  void clear_stats();
+  void print_stats();
+  void print_stats_csv();
+
+  void tick();
+};
 
 } // namespace NoC
 
+#include "network.tcc"
+
 #endif
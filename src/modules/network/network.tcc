@@ -0,0 +1,236 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Network On Chip
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+
+template<class v_t, class e_t>
+NoC::Network<v_t, e_t>::Network(const Topology& topology, uint64_t hop_latency, uint64_t buffer_depth) :
+  SimObj::Interconnect<v_t, e_t>(topology.get_nodes()), _topology(topology) {
+  assert(hop_latency > 0);
+  assert(buffer_depth > 0);
+  // Bubble flow control needs room for the bubble
+  assert(!topology.wraps() || buffer_depth > 1);
+  _hop_latency = hop_latency;
+  _buffer_depth = buffer_depth;
+  _buffers.resize(_num_ports);
+  _credits.resize(_num_ports);
+  _rr_next.resize(_num_ports);
+  _input_sent.resize(PORT_NUM, false);
+  _link_items.resize(_num_ports);
+  for(uint64_t node = 0; node < _num_ports; node++) {
+    for(int port = PORT_LOCAL; port < PORT_NUM; port++) {
+      _buffers[node].push_back(new Utility::RingBuffer<packet_t>(_buffer_depth));
+      _credits[node].push_back(_topology.has_link(node, (port_t)port) ? _buffer_depth : 0);
+    }
+    _rr_next[node].resize(PORT_NUM, 0);
+    _link_items[node].resize(PORT_NUM, 0);
+  }
+  _input_items.resize(_num_ports, 0);
+  _output_items.resize(_num_ports, 0);
+  _cycles = 0;
+  _total_latency = 0;
+  _total_hops = 0;
+  _credit_stalls = 0;
+  _bubble_stalls = 0;
+}
+
+template<class v_t, class e_t>
+NoC::Network<v_t, e_t>::~Network() {
+  for(auto & router : _buffers) {
+    for(auto & buffer : router) {
+      delete buffer;
+      buffer = NULL;
+    }
+  }
+}
+
+template<class v_t, class e_t>
+bool NoC::Network<v_t, e_t>::entering_ring(port_t in, port_t out) const {
+  bool in_x = in == PORT_EAST || in == PORT_WEST;
+  bool out_x = out == PORT_EAST || out == PORT_WEST;
+  return _topology.wraps() && (in == PORT_LOCAL || in_x != out_x);
+}
+
+template<class v_t, class e_t>
+bool NoC::Network<v_t, e_t>::send(uint64_t node, port_t in, port_t out) {
+  packet_t& packet = _buffers[node][in]->front();
+  if(out == PORT_LOCAL) {
+    if(_out_module[node]->is_stalled() != SimObj::STALL_CAN_ACCEPT) {
+      return false;
+    }
+    _out_module[node]->ready(packet.data);
+    _total_latency += _tick - packet.injected;
+    _output_items[node]++;
+    _items_processed++;
+  }
+  else {
+    uint64_t needed = entering_ring(in, out) ? 2 : 1;
+    if(_credits[node][out] < needed) {
+      _credit_stalls++;
+      if(_credits[node][out] != 0) {
+        _bubble_stalls++;
+      }
+      return false;
+    }
+    _credits[node][out]--;
+    _links.push_back({packet, _tick + _hop_latency, _topology.neighbor(node, out), opposite(out)});
+    _link_items[node][out]++;
+  }
+  _buffers[node][in]->pop();
+  if(in != PORT_LOCAL) {
+    // The slot is free again, tell the router upstream
+    _credit_returns.push_back({_tick + _hop_latency, _topology.neighbor(node, in), opposite(in)});
+  }
+  return true;
+}
+
+template<class v_t, class e_t>
+void NoC::Network<v_t, e_t>::ready(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data) {
+  assert(is_stalled(port, data) == SimObj::STALL_CAN_ACCEPT);
+  packet_t packet;
+  packet.data = data;
+  // Routed during the cycle the network ticks next
+  packet.injected = _tick + 1;
+  _buffers[port][PORT_LOCAL]->push(packet);
+  _input_items[port]++;
+  _total_hops += _topology.hops(port, route(data));
+}
+
+template<class v_t, class e_t>
+SimObj::stall_t NoC::Network<v_t, e_t>::is_stalled(uint64_t port, const Utility::pipeline_data<v_t, e_t>& data) {
+  return _buffers[port][PORT_LOCAL]->full() ? SimObj::STALL_PIPE : SimObj::STALL_CAN_ACCEPT;
+}
+
+template<class v_t, class e_t>
+void NoC::Network<v_t, e_t>::tick() {
+  _tick++;
+  _cycles++;
+  // Link and credit latencies are all hop_latency, both queues stay in arrival order
+  while(!_links.empty() && _links.front().arrive <= _tick) {
+    transfer_t& transfer = _links.front();
+    _buffers[transfer.node][transfer.port]->push(transfer.packet);
+    _links.pop_front();
+  }
+  while(!_credit_returns.empty() && _credit_returns.front().arrive <= _tick) {
+    _credits[_credit_returns.front().node][_credit_returns.front().port]++;
+    _credit_returns.pop_front();
+  }
+
+  // Every output port of every router forwards at most one buffer head, and
+  // every input port sends at most one, the next head waits a cycle
+  for(uint64_t node = 0; node < _num_ports; node++) {
+    std::fill(_input_sent.begin(), _input_sent.end(), false);
+    for(int out = PORT_LOCAL; out < PORT_NUM; out++) {
+      for(int i = 0; i < PORT_NUM; i++) {
+        port_t in = (port_t)((_rr_next[node][out] + i) % PORT_NUM);
+        if(_input_sent[in] || _buffers[node][in]->empty() || _topology.route(node, route(_buffers[node][in]->front().data)) != out) {
+          continue;
+        }
+        if(send(node, in, (port_t)out)) {
+          _input_sent[in] = true;
+          _rr_next[node][out] = (in + 1) % PORT_NUM;
+          break;
+        }
+      }
+    }
+  }
+}
+
+template<class v_t, class e_t>
+bool NoC::Network<v_t, e_t>::busy() {
+  if(!_links.empty()) {
+    return true;
+  }
+  for(auto & router : _buffers) {
+    for(auto & buffer : router) {
+      if(!buffer->empty()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+template<class v_t, class e_t>
+void NoC::Network<v_t, e_t>::clear_stats() {
+  for(auto & element : _input_items) {
+    element = 0;
+  }
+  for(auto & element : _output_items) {
+    element = 0;
+  }
+  for(auto & router : _link_items) {
+    for(auto & element : router) {
+      element = 0;
+    }
+  }
+  _items_processed = 0;
+  _cycles = 0;
+  _total_latency = 0;
+  _total_hops = 0;
+  _credit_stalls = 0;
+  _bubble_stalls = 0;
+}
+
+template<class v_t, class e_t>
+void NoC::Network<v_t, e_t>::print_stats() {
+  uint64_t traversals = 0;
+  for(auto & router : _link_items) {
+    for(auto & element : router) {
+      traversals += element;
+    }
+  }
+  SimObj::sim_out.write("-------------------------------------------------------------------------------\n");
+  SimObj::sim_out.write("[ " + _name + " ]\n");
+  SimObj::sim_out.write("  Topology:           " + topology_to_string(_topology.get_type()) + " " + std::to_string(_topology.get_width()) +
+                "x" + std::to_string(_topology.get_height()) + "\n");
+  SimObj::sim_out.write("  Performance:\n");
+  SimObj::sim_out.write("    Items Processed:  " + std::to_string(_items_processed) + "\n");
+  SimObj::sim_out.write("    Link Traversals:  " + std::to_string(traversals) + "\n");
+  SimObj::sim_out.write("    Credit Stalls:    " + std::to_string(_credit_stalls) + " cycles\n");
+  SimObj::sim_out.write("    Bubble Stalls:    " + std::to_string(_bubble_stalls) + " cycles\n");
+}
+
+template<class v_t, class e_t>
+void NoC::Network<v_t, e_t>::print_stats_csv() {
+  uint64_t traversals = 0;
+  uint64_t busiest = 0;
+  for(auto & router : _link_items) {
+    for(auto & element : router) {
+      traversals += element;
+      busiest = std::max(busiest, element);
+    }
+  }
+  uint64_t links = _topology.num_links();
+  SimObj::sim_out.write(_name + ",");
+  SimObj::sim_out.write("topology," + topology_to_string(_topology.get_type()) +
+                ",width," + std::to_string(_topology.get_width()) +
+                ",height," + std::to_string(_topology.get_height()) + ",");
+  SimObj::sim_out.write("input_distribution,");
+  for(auto & element : _input_items) {
+    SimObj::sim_out.write(std::to_string(element) + ",");
+  }
+  SimObj::sim_out.write("output_distribution,");
+  for(auto & element : _output_items) {
+    SimObj::sim_out.write(std::to_string(element) + ",");
+  }
+  SimObj::sim_out.write("performance," + std::to_string(_items_processed));
+  // Injected packets count their hops, ejected ones their latency
+  uint64_t injected = 0;
+  for(auto & element : _input_items) {
+    injected += element;
+  }
+  SimObj::sim_out.write(",avg_hops," + std::to_string(injected ? (double)_total_hops / (double)injected : 0.0) +
+                ",avg_latency," + std::to_string(_items_processed ? (double)_total_latency / (double)_items_processed : 0.0));
+  // Packets per cycle over all links and on the busiest one
+  SimObj::sim_out.write(",link_utilization," + std::to_string(_cycles && links ? (double)traversals / (double)(_cycles * links) : 0.0) +
+                ",max_link_utilization," + std::to_string(_cycles ? (double)busiest / (double)_cycles : 0.0) +
+                ",credit_stalls," + std::to_string(_credit_stalls) +
+                ",bubble_stalls," + std::to_string(_bubble_stalls) + "\n");
+}
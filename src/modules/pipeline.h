@@ -2,7 +2,7 @@
  *
  * Andrew Smith
  *
- * Single Graphicionado Pipeline, can be connected together via the crossbar module.
+ * Single Graphicionado Pipeline, can be connected together via an interconnect (crossbar or network).
  * Each pipeline get its own Scratchpad
  *
  * 10/07/19
@@ -19,8 +19,16 @@
 
 // Process Modules
 #include "module.h"
+#include "fifo.h"
 #include "memory.h"
-#include "crossbar.h"
+#include "cache.h"
+#include "scratchpad.h"
+#include "tracer.h"
+#include "streamPrefetcher.h"
+#include "indirectPrefetcher.h"
+#include "interconnect.h"
+#include "frontier.h"
+#include "functionalEngine.h"
 #include "readSrcProperty.h"
 #include "readSrcEdges.h"
 #include "readDstProperty.h"
@@ -39,6 +47,8 @@
 
 // Utility
 #include "option.h"
+#include "atomicQueue.h"
+#include "clockDomain.h"
 
 namespace SimObj {
 
@@ -46,10 +56,14 @@ template<class v_t, class e_t>
 class Pipeline {
 private:
   std::list<uint64_t>* apply;
-  std::list<uint64_t>* process;
-  Crossbar<v_t, e_t>* crossbar;
+  Utility::AtomicQueue<uint64_t>* process;
+  Interconnect<v_t, e_t>* interconnect;
   std::map<uint64_t, Utility::pipeline_data<v_t, e_t>>* scratchpad_map;
   SimObj::Memory* scratchpad;
+  Utility::ClockDomain scratchpad_clock;
+  SimObj::Cache* cache; // Vertex property cache for ReadDstProperty and WriteVertexProperty, NULL if disabled
+  SimObj::StreamPrefetcher* prefetcher; // Sequential reads, NULL if disabled
+  std::vector<SimObj::Tracer*> tracers; // Empty unless tracing
 
   SimObj::ReadSrcProperty<v_t, e_t>* p1;
   SimObj::ReadSrcEdges<v_t, e_t>* p2;
@@ -65,13 +79,22 @@ private:
   SimObj::Apply<v_t, e_t>* a3;
   SimObj::WriteVertexProperty<v_t, e_t>* a4;
 
+  std::vector<SimObj::Fifo<v_t, e_t>*> fifos; // Between stages given a depth
+  std::vector<SimObj::Module<v_t, e_t>*> process_modules; // Tick order
+  std::vector<SimObj::Module<v_t, e_t>*> apply_modules;
 
   uint64_t _tick;
   int _id;
 
+  // Link from to to, through a FIFO if stage has a depth
+  void connect(Module<v_t, e_t>* from, Module<v_t, e_t>* to, const Utility::Options& opt, const std::string& stage, std::vector<Module<v_t, e_t>*>& order);
+
+  // mem, or a tracer in front of it recording source's requests
+  Memory* traced(Memory* mem, Utility::TraceWriter* trace, const std::string& source);
+
 public:
   // Constructor:
-  Pipeline(uint64_t pipeline_id, const Utility::Options opt, Utility::readGraph<v_t>* graph, std::list<uint64_t>* process, GraphMat::GraphApp<v_t, e_t>* application, Memory* mem, Crossbar<v_t, e_t>* crossbar);
+  Pipeline(uint64_t pipeline_id, const Utility::Options opt, Utility::readGraph<v_t>* graph, Utility::AtomicQueue<uint64_t>* process, GraphMat::GraphApp<v_t, e_t>* application, Memory* mem, Interconnect<v_t, e_t>* interconnect, Frontier* frontier = NULL, IndirectPrefetcher* indirect = NULL, Utility::TraceWriter* trace = NULL, FunctionalEngine<v_t, e_t>* engine = NULL);
 
   // Destructor:
   ~Pipeline();
@@ -1,66 +1,128 @@
+#include <algorithm>
 #include <cassert>
 
 template<class v_t, class e_t>
-SimObj::Pipeline<v_t, e_t>::Pipeline(uint64_t pipeline_id, const Utility::Options opt, Utility::readGraph<v_t>* graph, std::list<uint64_t>* process, GraphMat::GraphApp<v_t, e_t>* application, Memory* mem, Crossbar<v_t, e_t>* crossbar) {
+SimObj::Pipeline<v_t, e_t>::Pipeline(uint64_t pipeline_id, const Utility::Options opt, Utility::readGraph<v_t>* graph, Utility::AtomicQueue<uint64_t>* process, GraphMat::GraphApp<v_t, e_t>* application, Memory* mem, Interconnect<v_t, e_t>* interconnect, Frontier* frontier, IndirectPrefetcher* indirect, Utility::TraceWriter* trace, FunctionalEngine<v_t, e_t>* engine) {
   // Assert inputs are OK
   assert(graph != NULL);
   assert(application != NULL);
   assert(mem != NULL);
-  assert(crossbar != NULL);
+  assert(interconnect != NULL);
   assert(process != NULL);
 
   // Allocate Scratchpad
   scratchpad_map = new std::map<uint64_t, Utility::pipeline_data<v_t, e_t>>;
-  scratchpad = new SimObj::Memory(opt.scratchpad_read_latency, opt.scratchpad_write_latency, opt.scratchpad_num_simultaneous_requests);
+  if(opt.scratchpad_banks != 0) {
+    SimObj::Scratchpad* banked = new SimObj::Scratchpad(opt.scratchpad_read_latency, opt.scratchpad_write_latency, opt.scratchpad_banks,
+                                                        opt.scratchpad_ports, opt.scratchpad_data_width, SimObj::bank_hash_from_string(opt.scratchpad_hash));
+    banked->set_name("Scratchpad " + std::to_string(pipeline_id));
+    scratchpad = banked;
+  }
+  else {
+    scratchpad = new SimObj::Memory(opt.scratchpad_read_latency, opt.scratchpad_write_latency, opt.scratchpad_num_simultaneous_requests);
+  }
+  scratchpad_clock = Utility::ClockDomain(opt.scratchpad_clock ? opt.scratchpad_clock : opt.pipeline_clock, opt.pipeline_clock);
   _id = pipeline_id;
 
+  // Stream prefetcher for the sequential vertex and edge reads
+  prefetcher = NULL;
+  Memory* stream_mem = mem;
+  if(opt.prefetch_depth != 0) {
+    prefetcher = new SimObj::StreamPrefetcher(mem, opt.prefetch_streams, opt.prefetch_depth, opt.prefetch_line, opt.prefetch_hit_latency);
+    prefetcher->set_name("StreamPrefetcher " + std::to_string(pipeline_id));
+    stream_mem = prefetcher;
+  }
+
+  // Vertex property cache for the destination reads and the Apply writes.
+  // Its fills, write-throughs and write-backs pass the prefetcher, which
+  // drops the stream lines they make stale.
+  cache = NULL;
+  if(opt.cache_capacity != 0) {
+    cache = new SimObj::Cache(stream_mem, opt.cache_capacity, opt.cache_ways, opt.cache_line,
+                              SimObj::replacement_from_string(opt.cache_replacement), opt.cache_mshrs,
+                              SimObj::write_policy_from_string(opt.cache_write_policy), opt.cache_hit_latency);
+    cache->set_name("Cache " + std::to_string(pipeline_id));
+  }
+
   // Allocate apply queue
   apply = new std::list<uint64_t>;
 
   // Allocate Pipeline Modules
-  p1 = new SimObj::ReadSrcProperty<v_t, e_t>(mem, process, graph);
-  p2 = new SimObj::ReadSrcEdges<v_t, e_t>(scratchpad, graph);
-  p3 = new SimObj::ReadDstProperty<v_t, e_t>(mem, graph);
+  std::string id = std::to_string(pipeline_id);
+  if(frontier != NULL) {
+    p1 = new SimObj::ReadSrcProperty<v_t, e_t>(traced(stream_mem, trace, "ReadSrcProperty " + id), frontier, pipeline_id, graph);
+  }
+  else {
+    p1 = new SimObj::ReadSrcProperty<v_t, e_t>(traced(stream_mem, trace, "ReadSrcProperty " + id), process, graph);
+  }
+  if(opt.edge_burst) {
+    // Neighbor ids and weights are streamed in dram_width lines
+    assert(opt.dram_data_width >= sizeof(uint32_t) && opt.dram_data_width >= sizeof(e_t));
+    p2 = new SimObj::ReadSrcEdges<v_t, e_t>(scratchpad, traced(stream_mem, trace, "ReadSrcEdges " + id), opt.dram_data_width, graph);
+  }
+  else {
+    p2 = new SimObj::ReadSrcEdges<v_t, e_t>(scratchpad, graph);
+  }
+  p3 = new SimObj::ReadDstProperty<v_t, e_t>(traced(cache ? cache : mem, trace, "ReadDstProperty " + id), graph);
+  if(indirect != NULL) {
+    // Prefetches for this pipeline's destinations go through the same memory
+    indirect->connect(pipeline_id, traced(cache ? cache : mem, trace, "IndirectPrefetcher " + id));
+    p2->set_indirect_prefetcher(indirect);
+    p3->set_indirect_prefetcher(indirect, pipeline_id);
+  }
+  // Reads each DRAM facing stage keeps in flight
+  bool in_order = (opt.mem_order == "in_order");
+  // The engine streams edges in the order vertices were read
+  p1->set_request_slots(opt.mem_slots, in_order || engine != NULL);
+  p3->set_request_slots(opt.mem_slots, in_order);
   p4 = new SimObj::ProcessEdge<v_t, e_t>(1, application);
-  p5 = new SimObj::ControlAtomicUpdate<v_t, e_t>;
+  if(engine != NULL) {
+    // Functional results come from the engine's streams
+    p1->set_stream(engine->get_stream(pipeline_id));
+    p2->set_stream(engine->get_stream(pipeline_id));
+    p4->set_decoupled(true);
+  }
+  // ReadTempDstProperty, Reduce and WriteTempDstProperty hold at most one
+  // edge each past the atomic unit, one spare entry, plus the FIFOs between them
+  uint64_t cau_depth = opt.cau_depth;
+  if(cau_depth == 0) {
+    cau_depth = 4 + opt.get_fifo_depth("ControlAtomicUpdate") + opt.get_fifo_depth("ReadTempDstProperty") + opt.get_fifo_depth("Reduce");
+  }
+  p5 = new SimObj::ControlAtomicUpdate<v_t, e_t>(cau_depth);
   p6 = new SimObj::ReadTempDstProperty<v_t, e_t>(scratchpad, graph, scratchpad_map);
   p7 = new SimObj::Reduce<v_t, e_t>(1, application);
-  p8 = new SimObj::WriteTempDstProperty<v_t, e_t>(scratchpad, p5, scratchpad_map, apply);
+  p8 = new SimObj::WriteTempDstProperty<v_t, e_t>(scratchpad, graph, p5, scratchpad_map, apply);
 
-  a1 = new SimObj::ReadVertexProperty<v_t, e_t>(mem, apply, graph);
+  a1 = new SimObj::ReadVertexProperty<v_t, e_t>(traced(stream_mem, trace, "ReadVertexProperty " + id), apply, graph);
+  a1->set_request_slots(opt.mem_slots, in_order);
   a2 = new SimObj::ReadTempVertexProperty<v_t, e_t>(scratchpad, graph, scratchpad_map);
   a3 = new SimObj::Apply<v_t, e_t>(1, application);
-  a4 = new SimObj::WriteVertexProperty<v_t, e_t>(mem, process, graph);
+  // Writes go through the prefetcher to drop stale buffered lines
+  a4 = new SimObj::WriteVertexProperty<v_t, e_t>(traced(cache ? cache : stream_mem, trace, "WriteVertexProperty " + id), process, graph);
   
-  // Connect Pipeline
-  p1->set_next(p2);
+  // Connect Pipeline, modules are ticked in the order they are connected
   p1->set_prev(NULL);
-  p2->set_next(crossbar);
-  p2->set_prev(p1);
-  // Crossbar goes here:
-  crossbar->connect_input(p2, pipeline_id);
-  crossbar->connect_output(p3, pipeline_id);
-  p3->set_next(p4);
-  p3->set_prev(crossbar);
-  p4->set_next(p5);
-  p4->set_prev(p3);
-  p5->set_next(p6);
-  p5->set_prev(p4);
-  p6->set_next(p7);
-  p6->set_prev(p5);
-  p7->set_next(p8);
-  p7->set_prev(p6);
+  connect(p1, p2, opt, "ReadSrcProperty", process_modules);
+  p2->set_next(interconnect->get_input(pipeline_id));
+  process_modules.push_back(p2);
+  // Interconnect goes here:
+  interconnect->connect_input(p2, pipeline_id);
+  interconnect->connect_output(p3, pipeline_id);
+  p3->set_prev(interconnect);
+  connect(p3, p4, opt, "ReadDstProperty", process_modules);
+  connect(p4, p5, opt, "ProcessEdge", process_modules);
+  connect(p5, p6, opt, "ControlAtomicUpdate", process_modules);
+  connect(p6, p7, opt, "ReadTempDstProperty", process_modules);
+  connect(p7, p8, opt, "Reduce", process_modules);
   p8->set_next(NULL);
-  p8->set_prev(p7);
+  process_modules.push_back(p8);
 
   a1->set_prev(NULL);
-  a1->set_next(a2);
-  a2->set_prev(a1);
-  a2->set_next(a3);
-  a3->set_prev(a2);
-  a3->set_next(a4);
-  a4->set_prev(a3);
+  connect(a1, a2, opt, "ReadVertexProperty", apply_modules);
+  connect(a2, a3, opt, "ReadTempVertexProperty", apply_modules);
+  connect(a3, a4, opt, "Apply", apply_modules);
   a4->set_next(NULL);
+  apply_modules.push_back(a4);
 
   // Name Modules
   p1->set_name("ReadSrcProperty " + std::to_string(pipeline_id));
@@ -84,6 +146,16 @@ SimObj::Pipeline<v_t, e_t>::~Pipeline() {
   scratchpad_map = NULL;
   delete scratchpad;
   scratchpad = NULL;
+  delete cache;
+  cache = NULL;
+  delete prefetcher;
+  prefetcher = NULL;
+  for(auto & tracer : tracers) {
+    delete tracer;
+  }
+  for(auto & fifo : fifos) {
+    delete fifo;
+  }
   delete apply;
   apply = NULL;
 
@@ -114,42 +186,71 @@ SimObj::Pipeline<v_t, e_t>::~Pipeline() {
   a4 = NULL;
 
   process = NULL;
-  crossbar = NULL;
+  interconnect = NULL;
+}
+
+template<class v_t, class e_t>
+SimObj::Memory* SimObj::Pipeline<v_t, e_t>::traced(Memory* mem, Utility::TraceWriter* trace, const std::string& source) {
+  if(trace == NULL) {
+    return mem;
+  }
+  tracers.push_back(new SimObj::Tracer(mem, trace, source));
+  return tracers.back();
+}
+
+template<class v_t, class e_t>
+void SimObj::Pipeline<v_t, e_t>::connect(Module<v_t, e_t>* from, Module<v_t, e_t>* to, const Utility::Options& opt, const std::string& stage, std::vector<Module<v_t, e_t>*>& order) {
+  order.push_back(from);
+  uint64_t depth = opt.get_fifo_depth(stage);
+  if(depth == 0) {
+    from->set_next(to);
+    to->set_prev(from);
+    return;
+  }
+  SimObj::Fifo<v_t, e_t>* fifo = new SimObj::Fifo<v_t, e_t>(depth);
+  fifo->set_name("Fifo " + stage + " " + std::to_string(_id));
+  from->set_next(fifo);
+  fifo->set_prev(from);
+  fifo->set_next(to);
+  to->set_prev(fifo);
+  fifos.push_back(fifo);
+  order.push_back(fifo);
 }
 
 template<class v_t, class e_t>
 void SimObj::Pipeline<v_t, e_t>::tick_process() {
   _tick++;
-  p1->tick();
-  p2->tick();
-  p3->tick();
-  p4->tick();
-  p5->tick();
-  p6->tick();
-  p7->tick();
-  p8->tick();
-  scratchpad->tick();
+  for(auto & module : process_modules) {
+    module->tick();
+  }
+  for(uint64_t i = scratchpad_clock.advance(); i > 0; i--) {
+    scratchpad->tick();
+  }
+  if(cache) cache->tick();
+  if(prefetcher) prefetcher->tick();
 }
 
 template<class v_t, class e_t>
 void SimObj::Pipeline<v_t, e_t>::tick_apply() {
   _tick++;
-  a1->tick();
-  a2->tick();
-  a3->tick();
-  a4->tick();
-  scratchpad->tick();
+  for(auto & module : apply_modules) {
+    module->tick();
+  }
+  for(uint64_t i = scratchpad_clock.advance(); i > 0; i--) {
+    scratchpad->tick();
+  }
+  if(cache) cache->tick();
+  if(prefetcher) prefetcher->tick();
 }
 
 template<class v_t, class e_t>
 bool SimObj::Pipeline<v_t, e_t>::process_complete() {
-  return (!p1->busy() && !p2->busy() && !p3->busy() && !p4->busy() &&
-          !p5->busy() && !p6->busy() && !p7->busy() && !p8->busy());
+  return std::none_of(process_modules.begin(), process_modules.end(), [](Module<v_t, e_t>* a) {return a->busy();});
 }
 
 template<class v_t, class e_t>
 bool SimObj::Pipeline<v_t, e_t>::apply_complete() {
-  return (!a1->busy() && !a2->busy() && !a3->busy() && !a4->busy());
+  return std::none_of(apply_modules.begin(), apply_modules.end(), [](Module<v_t, e_t>* a) {return a->busy();});
 }
 
 template<class v_t, class e_t>
@@ -185,6 +286,12 @@ void SimObj::Pipeline<v_t, e_t>::print_stats() {
   a2->print_stats();
   a3->print_stats();
   a4->print_stats();
+  for(auto & fifo : fifos) {
+    fifo->print_stats();
+  }
+  scratchpad->print_stats();
+  if(cache) cache->print_stats();
+  if(prefetcher) prefetcher->print_stats();
 }
 
 template<class v_t, class e_t>
@@ -202,6 +309,12 @@ void SimObj::Pipeline<v_t, e_t>::print_stats_csv() {
   a2->print_stats_csv();
   a3->print_stats_csv();
   a4->print_stats_csv();
+  for(auto & fifo : fifos) {
+    fifo->print_stats_csv();
+  }
+  scratchpad->print_stats_csv();
+  if(cache) cache->print_stats_csv();
+  if(prefetcher) prefetcher->print_stats_csv();
 }
 
 template<class v_t, class e_t>
@@ -218,4 +331,10 @@ void SimObj::Pipeline<v_t, e_t>::clear_stats() {
   a2->clear_stats();
   a3->clear_stats();
   a4->clear_stats();
+  for(auto & fifo : fifos) {
+    fifo->clear_stats();
+  }
+  scratchpad->clear_stats();
+  if(cache) cache->clear_stats();
+  if(prefetcher) prefetcher->clear_stats();
 }
@@ -49,6 +49,7 @@ private:
   uint64_t _counter;
   uint64_t _delay_cycles;
   GraphMat::GraphApp<v_t, e_t>* _graph_app;
+  bool _decoupled; // Updates arrive precomputed by the functional engine
 
 public:
   ProcessEdge();
@@ -56,6 +57,7 @@ public:
   ~ProcessEdge();
 
   void tick(void);
+  void set_decoupled(bool decoupled);
 };
 
 } // namespace SimObj
@@ -16,6 +16,7 @@ SimObj::ProcessEdge<v_t, e_t>::ProcessEdge() {
   _ready = false;
   _counter = 0;
   _delay_cycles = 1;
+  _decoupled = false;
 }
 
 template<class v_t, class e_t>
@@ -27,6 +28,7 @@ SimObj::ProcessEdge<v_t, e_t>::ProcessEdge(int delay_cycles, GraphMat::GraphApp<
   _ready = false;
   _counter = 0;
   _delay_cycles = delay_cycles;
+  _decoupled = false;
 }
 
 template<class v_t, class e_t>
@@ -37,7 +39,7 @@ SimObj::ProcessEdge<v_t, e_t>::~ProcessEdge() {
 template<class v_t, class e_t>
 void SimObj::ProcessEdge<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -67,7 +69,9 @@ void SimObj::ProcessEdge<v_t, e_t>::tick(void) {
       }
       else {
         if(_next->is_stalled() == STALL_CAN_ACCEPT) {
-          _graph_app->process_edge(_data.message_data, _data.edge_data, _data.vertex_data);
+          if(!_decoupled) {
+            _graph_app->process_edge(_data.message_data, _data.edge_data, _data.vertex_data);
+          }
           _next->ready(_data);
           next_state = OP_WAIT;
           _stall = STALL_CAN_ACCEPT;
@@ -93,3 +97,7 @@ void SimObj::ProcessEdge<v_t, e_t>::tick(void) {
   this->update_stats();
 }
 
+template<class v_t, class e_t>
+void SimObj::ProcessEdge<v_t, e_t>::set_decoupled(bool decoupled) {
+  _decoupled = decoupled;
+}
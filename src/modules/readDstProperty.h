@@ -3,7 +3,7 @@
  *
  * Read DST Property:
  *  Read the destination property from DRAM. Optional depending on the 
- *  graph algorithm
+ *  graph algorithm. Checks the indirect prefetch buffer first if there is one.
  *
  */
 
@@ -17,6 +17,8 @@
 
 #include "module.h"
 #include "memory.h"
+#include "indirectPrefetcher.h"
+#include "requestSlots.h"
 
 #include "readGraph.h"
 
@@ -49,14 +51,18 @@ private:
   Memory* _dram;
   op_t _state;
   Utility::readGraph<v_t>* _graph;
+  IndirectPrefetcher* _indirect;
+  uint64_t _port;
+  RequestSlots<Utility::pipeline_data<v_t, e_t>> _slots; // Reads in flight
 
 public:
-  bool _mem_flag;
   ReadDstProperty();
   ReadDstProperty(Memory* dram, Utility::readGraph<v_t>* graph);
   ~ReadDstProperty();
 
   void tick(void);
+  void set_indirect_prefetcher(IndirectPrefetcher* indirect, uint64_t port);
+  void set_request_slots(uint64_t num_slots, bool in_order);
 };
 
 } // namespace SimObj
@@ -3,7 +3,7 @@
  *
  * Read DST Property:
  *  Read the destination property from DRAM. Optional depending on the 
- *  graph algorithm
+ *  graph algorithm. Checks the indirect prefetch buffer first if there is one.
  *
  */
 
@@ -15,8 +15,9 @@ SimObj::ReadDstProperty<v_t, e_t>::ReadDstProperty() {
   _dram = NULL;
   _graph = NULL;
   _ready = false;
-  _mem_flag = false;
   _state = OP_WAIT;
+  _indirect = NULL;
+  _port = 0;
 }
 
 
@@ -27,8 +28,9 @@ SimObj::ReadDstProperty<v_t, e_t>::ReadDstProperty(Memory* dram, Utility::readGr
   _graph = graph;
   _dram = dram;
   _ready = false;
-  _mem_flag = false;
   _state = OP_WAIT;
+  _indirect = NULL;
+  _port = 0;
 }
 
 
@@ -36,13 +38,26 @@ template<class v_t, class e_t>
 SimObj::ReadDstProperty<v_t, e_t>::~ReadDstProperty() {
   _graph = NULL;
   _dram = NULL;
+  _indirect = NULL;
 }
 
 
+template<class v_t, class e_t>
+void SimObj::ReadDstProperty<v_t, e_t>::set_indirect_prefetcher(IndirectPrefetcher* indirect, uint64_t port) {
+  _indirect = indirect;
+  _port = port;
+}
+
+
+template<class v_t, class e_t>
+void SimObj::ReadDstProperty<v_t, e_t>::set_request_slots(uint64_t num_slots, bool in_order) {
+  _slots = RequestSlots<Utility::pipeline_data<v_t, e_t>>(num_slots, in_order);
+}
+
 template<class v_t, class e_t>
 void SimObj::ReadDstProperty<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -53,44 +68,46 @@ void SimObj::ReadDstProperty<v_t, e_t>::tick(void) {
         std::cout << "Tick:" << _tick << " " << _name << " recieved: " << _data << "\n";
 #endif
         _ready = false;
-        _mem_flag = false;
         _data.vertex_dst_id = _graph->getNodeNeighbor(_data.edge_id);
         _data.vertex_dst_id_addr = _graph->getVertexAddress(_data.vertex_dst_id);
-        _dram->read(_data.vertex_dst_id_addr, &_mem_flag, false);
-        _stall = STALL_MEM;
-        next_state = OP_MEM_WAIT;
-      }
-      else {
-        // Wait for upstream to send vertex
-        next_state = OP_WAIT;
-        _stall = STALL_CAN_ACCEPT;
+        bool* complete = _slots.issue(_data);
+        if(_indirect == NULL || !_indirect->lookup(_port, _data.vertex_dst_id_addr, complete)) {
+          _dram->read(_data.vertex_dst_id_addr, complete, false);
+        }
       }
       break;
     }
     case OP_MEM_WAIT : {
-      if(_mem_flag) {
-        _data.vertex_dst_data = _graph->getVertexProperty(_data.vertex_dst_id);
-        if(_next->is_stalled() == STALL_CAN_ACCEPT) {
-          _next->ready(_data);
-          _stall = STALL_CAN_ACCEPT;
-          next_state = OP_WAIT;
-          _has_work = false;
-        }
-        else {
-          next_state = OP_MEM_WAIT;
-          _stall = STALL_PIPE;
-        }
-      }
-      else {
-        next_state = OP_MEM_WAIT;
-        _stall = STALL_MEM;
-      }
+      // Every slot has a read in flight
       break;
     }
     default : {
 
     }
   }
+
+  // Send the next completed read downstream
+  Utility::pipeline_data<v_t, e_t>* done = _slots.peek();
+  bool blocked = false;
+  if(done != NULL) {
+    if(_next->is_stalled() == STALL_CAN_ACCEPT) {
+      done->vertex_dst_data = _graph->getVertexProperty(done->vertex_dst_id);
+      _next->ready(*done);
+      _slots.pop();
+    }
+    else {
+      blocked = true;
+    }
+  }
+  if(_slots.full()) {
+    next_state = OP_MEM_WAIT;
+    _stall = blocked ? STALL_PIPE : STALL_MEM;
+  }
+  else {
+    next_state = OP_WAIT;
+    _stall = STALL_CAN_ACCEPT;
+  }
+  _has_work = !_slots.empty();
 #if 0
   if(_state != next_state) {
     std::cout << "[ " << __PRETTY_FUNCTION__ << " ] tick: " << _tick << "  state: " << _state_name[_state] << "  next_state: " << _state_name[next_state] << "\n";
@@ -3,7 +3,8 @@
  *
  * Read SRC Edges:
  *  The Read SRC Edges Module is the second module in the pipeline.
- *  It reads the list of edges of the current vertex from Scratchpad Memory.
+ *  It reads the list of edges of the current vertex from Scratchpad Memory,
+ *  or in burst mode streams them from DRAM, one dram_width line at a time.
  *
  */
 
@@ -18,6 +19,8 @@
 
 #include "module.h"
 #include "memory.h"
+#include "indirectPrefetcher.h"
+#include "functionalEngine.h"
 
 #include "readGraph.h"
 
@@ -46,21 +49,53 @@ private:
   using Module<v_t, e_t>::_data;
   using Module<v_t, e_t>::_name;
   using Module<v_t, e_t>::_has_work;
+  using Module<v_t, e_t>::_stall_ticks;
+  using Module<v_t, e_t>::_items_processed;
 
   Memory* _scratchpad;
+  Memory* _dram;
   op_t _state;
   std::queue<uint>* _edge_list;
   Utility::readGraph<v_t>* _graph;
   bool _data_set;
 
+  // Burst mode, disabled while _burst_size is 0
+  uint64_t _burst_size;
+  bool _burst_open;        // The lines below hold the last edge's data
+  uint64_t _last_edge;
+  uint64_t _neighbor_line;
+  uint64_t _weight_line;
+  bool _weight_flag;
+  uint64_t _bursts;
+  uint64_t _burst_edges;
+
+  void request_edge(void);
+
+  // Indirect prefetch, edge positions of the current list
+  IndirectPrefetcher* _indirect;
+  uint64_t _edge_pos;     // Next edge to send
+  uint64_t _prefetch_pos; // Next edge to prefetch for
+  uint64_t _prefetch_end;
+
+  void run_ahead(void);
+
+  // Destinations and updates, NULL unless decoupled
+  FunctionalStream<v_t, e_t>* _stream;
+
 public:
   bool _mem_flag;
   ReadSrcEdges();
   ReadSrcEdges(Memory* dram, Utility::readGraph<v_t>* graph);
+  ReadSrcEdges(Memory* scratchpad, Memory* dram, uint64_t burst_size, Utility::readGraph<v_t>* graph);
   ~ReadSrcEdges();
 
   void tick(void);
-  void ready(Utility::pipeline_data<v_t, e_t> data);
+  void ready(const Utility::pipeline_data<v_t, e_t>& data);
+  void print_stats(void);
+  void print_stats_csv(void);
+  void clear_stats(void);
+  void set_indirect_prefetcher(IndirectPrefetcher* indirect);
+  void set_stream(FunctionalStream<v_t, e_t>* stream);
 };
 
 } // namespace SimObj
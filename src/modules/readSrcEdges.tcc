@@ -3,19 +3,38 @@
  *
  * Read SRC Edges:
  *  The Read SRC Edges Module is the second module in the pipeline.
- *  It reads the list of edges of the current vertex from Scratchpad Memory.
+ *  It reads the list of edges of the current vertex from Scratchpad Memory,
+ *  or in burst mode streams them from DRAM. A burst reads the _burst_size
+ *  aligned line holding an edge's neighbor id, and the following edges are
+ *  served from it while they are contiguous; weights are read the same way.
  *
  */
 
+#include <algorithm>
 #include <cassert>
 
 template<class v_t, class e_t>
 SimObj::ReadSrcEdges<v_t, e_t>::ReadSrcEdges() {
   _scratchpad = NULL;
+  _dram = NULL;
   _graph = NULL;
   _state = OP_WAIT;
   _ready = false;
   _mem_flag = false;
+  _weight_flag = false;
+  _burst_size = 0;
+  _burst_open = false;
+  _last_edge = 0;
+  _neighbor_line = 0;
+  _weight_line = 0;
+  _bursts = 0;
+  _burst_edges = 0;
+  _edge_list = NULL;
+  _indirect = NULL;
+  _edge_pos = 0;
+  _prefetch_pos = 0;
+  _prefetch_end = 0;
+  _stream = NULL;
 }
 
 
@@ -24,24 +43,99 @@ SimObj::ReadSrcEdges<v_t, e_t>::ReadSrcEdges(Memory* scratchpad, Utility::readGr
   assert(scratchpad != NULL);
   assert(graph != NULL);
   _scratchpad = scratchpad;
+  _dram = NULL;
   _graph = graph;
   _state = OP_WAIT;
   _ready = false;
   _mem_flag = false;
+  _weight_flag = false;
+  _burst_size = 0;
+  _burst_open = false;
+  _last_edge = 0;
+  _neighbor_line = 0;
+  _weight_line = 0;
+  _bursts = 0;
+  _burst_edges = 0;
+  _edge_list = NULL;
+  _indirect = NULL;
+  _edge_pos = 0;
+  _prefetch_pos = 0;
+  _prefetch_end = 0;
+  _stream = NULL;
+}
+
+
+template<class v_t, class e_t>
+SimObj::ReadSrcEdges<v_t, e_t>::ReadSrcEdges(Memory* scratchpad, Memory* dram, uint64_t burst_size, Utility::readGraph<v_t>* graph) : ReadSrcEdges(scratchpad, graph) {
+  assert(burst_size == 0 || dram != NULL);
+  _dram = dram;
+  _burst_size = burst_size;
 }
 
 
 template<class v_t, class e_t>
 SimObj::ReadSrcEdges<v_t, e_t>::~ReadSrcEdges() {
   _scratchpad = NULL;
+  _dram = NULL;
   _graph = NULL;
 }
 
 
+template<class v_t, class e_t>
+void SimObj::ReadSrcEdges<v_t, e_t>::request_edge(void) {
+  _mem_flag = false;
+  _weight_flag = true;
+  if(_burst_size == 0) {
+    _scratchpad->read(_graph->getNeighborAddress(_edge_list->front()), &_mem_flag);
+    return;
+  }
+  uint64_t edge = _edge_list->front();
+  uint64_t neighbor_line = _graph->getNeighborAddress(edge) / _burst_size;
+  uint64_t weight_line = _graph->getEdgeWeightAddress(edge) / _burst_size;
+  // A burst ends at the first edge not next to the last one in the edge
+  // arrays (sliced lists skip positions), or past the end of its line
+  bool contiguous = _burst_open && edge == _last_edge + 1;
+  if(contiguous && neighbor_line == _neighbor_line) {
+    _mem_flag = true;
+  }
+  else {
+    _dram->read(neighbor_line * _burst_size, &_mem_flag);
+    _bursts++;
+  }
+  if(!contiguous || weight_line != _weight_line) {
+    _weight_flag = false;
+    _dram->read(weight_line * _burst_size, &_weight_flag);
+  }
+  _burst_open = true;
+  _last_edge = edge;
+  _neighbor_line = neighbor_line;
+  _weight_line = weight_line;
+  _burst_edges++;
+}
+
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcEdges<v_t, e_t>::run_ahead(void) {
+  if(_indirect == NULL || _edge_list == NULL) {
+    return;
+  }
+  _prefetch_pos = std::max(_prefetch_pos, _edge_pos);
+  while(_prefetch_pos < _prefetch_end && _prefetch_pos < _edge_pos + _indirect->get_lookahead()) {
+    uint64_t dst = _graph->getNodeNeighbor(_graph->getEdgeAt(_prefetch_pos));
+    if(!_indirect->prefetch(dst, _graph->getVertexAddress(dst))) {
+      // Destination buffer is full, try again next cycle
+      break;
+    }
+    _prefetch_pos++;
+  }
+}
+
+
 template<class v_t, class e_t>
 void SimObj::ReadSrcEdges<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
+  run_ahead();
 
   // Module State Machine
   switch(_state) {
@@ -54,15 +148,17 @@ void SimObj::ReadSrcEdges<v_t, e_t>::tick(void) {
         _ready = false;
         if(!_edge_list->empty()) {
           _data_set = false;
-          _mem_flag = false;
-          _scratchpad->read(0x01, &_mem_flag);
+          request_edge();
           _stall = STALL_MEM;
           next_state = OP_MEM_WAIT;
         }
         else {
-          // Edge List is Empty
+          // Edge List is Empty (no edges, or none in the active slice)
+          delete _edge_list;
+          _edge_list = NULL;
           next_state = OP_WAIT;
           _stall = STALL_CAN_ACCEPT;
+          _has_work = false;
         }
       }
       else {
@@ -73,19 +169,29 @@ void SimObj::ReadSrcEdges<v_t, e_t>::tick(void) {
       break;
     }
     case OP_MEM_WAIT : {
-      if(_mem_flag) {
+      if(_mem_flag && _weight_flag) {
         if(_data_set == false) {
           _data.edge_id = _edge_list->front();
           _edge_list->pop();
-          _data.edge_data = _graph->getEdgeWeight(_data.edge_id);
-          _data.vertex_dst_id = _graph->getNodeNeighbor(_data.edge_id);
+          _edge_pos++;
+          if(_stream != NULL) {
+            // The update was computed by the functional engine
+            edge_event_t<v_t, e_t> event = _stream->pop_edge();
+            assert(event.edge_id == _data.edge_id);
+            _data.edge_data = event.weight;
+            _data.vertex_dst_id = event.dst;
+            _data.message_data = event.update;
+          }
+          else {
+            _data.edge_data = _graph->getEdgeWeight(_data.edge_id);
+            _data.vertex_dst_id = _graph->getNodeNeighbor(_data.edge_id);
+          }
           _data_set = true;
         }
         if(_next->is_stalled(_data) == STALL_CAN_ACCEPT) {
           if(!_edge_list->empty()) {
             _data_set = false;
-            _mem_flag = false;
-            _scratchpad->read(0x01, &_mem_flag);
+            request_edge();
             _stall = STALL_MEM;
             next_state = OP_MEM_WAIT;
             _data.last_edge = false;
@@ -125,9 +231,52 @@ void SimObj::ReadSrcEdges<v_t, e_t>::tick(void) {
 }
 
 template<class v_t, class e_t>
-void SimObj::ReadSrcEdges<v_t, e_t>::ready(Utility::pipeline_data<v_t, e_t> data) {
+void SimObj::ReadSrcEdges<v_t, e_t>::ready(const Utility::pipeline_data<v_t, e_t>& data) {
   _ready = true;
   _has_work = true;
   _data = data;
-  _edge_list = _graph->getEdges(data.vertex_id);
+  _edge_list = _graph->getEdges(data.vertex_id, data.edge_id);
+  _burst_open = false;
+  _edge_pos = data.edge_id;
+  _prefetch_pos = data.edge_id;
+  _prefetch_end = _graph->getChunkEnd(data.vertex_id, data.edge_id);
+}
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcEdges<v_t, e_t>::set_indirect_prefetcher(IndirectPrefetcher* indirect) {
+  _indirect = indirect;
+}
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcEdges<v_t, e_t>::set_stream(FunctionalStream<v_t, e_t>* stream) {
+  _stream = stream;
+}
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcEdges<v_t, e_t>::print_stats(void) {
+  Module<v_t, e_t>::print_stats();
+  if(_burst_size != 0) {
+    sim_out.write("    Bursts:           " + std::to_string(_bursts) + "\n");
+    sim_out.write("    Edges/Burst:      " + std::to_string(_bursts ? (double)_burst_edges / (double)_bursts : 0.0) + "\n");
+  }
+}
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcEdges<v_t, e_t>::print_stats_csv(void) {
+  // Burst columns follow the Module ones, 0 without edge bursts
+  sim_out.write(_name + ","
+    + std::to_string(_stall_ticks[STALL_CAN_ACCEPT]) + ","
+    + std::to_string(_stall_ticks[STALL_PROCESSING]) + ","
+    + std::to_string(_stall_ticks[STALL_PIPE]) + ","
+    + std::to_string(_stall_ticks[STALL_MEM]) + ","
+    + std::to_string(_items_processed) + ","
+    + std::to_string(_burst_edges) + ","
+    + std::to_string(_bursts) + "\n");
+}
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcEdges<v_t, e_t>::clear_stats(void) {
+  Module<v_t, e_t>::clear_stats();
+  _bursts = 0;
+  _burst_edges = 0;
 }
@@ -17,10 +17,13 @@
 #include <vector>
 #include <cstdint>
 #include <map>
-#include <list>
 
 #include "module.h"
 #include "memory.h"
+#include "atomicQueue.h"
+#include "frontier.h"
+#include "functionalEngine.h"
+#include "requestSlots.h"
 
 #include "readGraph.h"
 
@@ -32,6 +35,7 @@ private:
   enum op_t {
     OP_WAIT,
     OP_MEM_WAIT,
+    OP_STEAL_WAIT,
     OP_NUM_OPS
   };
 
@@ -39,7 +43,8 @@ private:
   std::map<int, std::string> _state_name = {
     {0, "OP_WAIT"},
     {1, "OP_MEM_WAIT"},
-    {2, "OP_NUM_OPS"}};
+    {2, "OP_STEAL_WAIT"},
+    {3, "OP_NUM_OPS"}};
 #endif
 
   using Module<v_t, e_t>::_tick;
@@ -53,18 +58,24 @@ private:
   Memory* _dram;
   op_t _state;
   bool _fetched;
-  std::list<uint64_t>* _process;
+  Utility::AtomicQueue<uint64_t>* _process;
+  Frontier* _frontier;
+  uint64_t _pipeline_id;
+  uint64_t _counter;
   Utility::readGraph<v_t>* _graph;
+  FunctionalStream<v_t, e_t>* _stream; // Vertices and properties, NULL unless decoupled
+  RequestSlots<Utility::pipeline_data<v_t, e_t>> _slots; // Reads in flight
 
 public:
-  bool _mem_flag;
-
   uint64_t _vertex_id;
   ReadSrcProperty();
-  ReadSrcProperty(Memory* dram, std::list<uint64_t>* process, Utility::readGraph<v_t>* graph);
+  ReadSrcProperty(Memory* dram, Utility::AtomicQueue<uint64_t>* process, Utility::readGraph<v_t>* graph);
+  ReadSrcProperty(Memory* dram, Frontier* frontier, uint64_t pipeline_id, Utility::readGraph<v_t>* graph);
   ~ReadSrcProperty();
 
   void tick(void);
+  void set_stream(FunctionalStream<v_t, e_t>* stream);
+  void set_request_slots(uint64_t num_slots, bool in_order);
 };
 
 } // namespace SimObj
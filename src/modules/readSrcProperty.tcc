@@ -16,24 +16,47 @@ template<class v_t, class e_t>
 SimObj::ReadSrcProperty<v_t, e_t>::ReadSrcProperty() {
   _dram = NULL;
   _process = NULL;
+  _frontier = NULL;
+  _pipeline_id = 0;
+  _counter = 0;
   _graph = NULL;
   _state = OP_WAIT;
-  _mem_flag = false;
   _fetched = false;
+  _stream = NULL;
 }
 
 
 template<class v_t, class e_t>
-SimObj::ReadSrcProperty<v_t, e_t>::ReadSrcProperty(Memory* dram, std::list<uint64_t>* process, Utility::readGraph<v_t>* graph) {
+SimObj::ReadSrcProperty<v_t, e_t>::ReadSrcProperty(Memory* dram, Utility::AtomicQueue<uint64_t>* process, Utility::readGraph<v_t>* graph) {
   assert(dram != NULL);
   assert(process != NULL);
   assert(graph != NULL);
   _graph = graph;
   _dram = dram;
   _process = process;
+  _frontier = NULL;
+  _pipeline_id = 0;
+  _counter = 0;
   _state = OP_WAIT;
-  _mem_flag = false;
   _fetched = false;
+  _stream = NULL;
+}
+
+
+template<class v_t, class e_t>
+SimObj::ReadSrcProperty<v_t, e_t>::ReadSrcProperty(Memory* dram, Frontier* frontier, uint64_t pipeline_id, Utility::readGraph<v_t>* graph) {
+  assert(dram != NULL);
+  assert(frontier != NULL);
+  assert(graph != NULL);
+  _graph = graph;
+  _dram = dram;
+  _process = NULL;
+  _frontier = frontier;
+  _pipeline_id = pipeline_id;
+  _counter = 0;
+  _state = OP_WAIT;
+  _fetched = false;
+  _stream = NULL;
 }
 
 
@@ -41,6 +64,7 @@ template<class v_t, class e_t>
 SimObj::ReadSrcProperty<v_t, e_t>::~ReadSrcProperty() {
   _dram = NULL;
   _process = NULL;
+  _frontier = NULL;
   _graph = NULL;
 }
 
@@ -48,21 +72,49 @@ SimObj::ReadSrcProperty<v_t, e_t>::~ReadSrcProperty() {
 template<class v_t, class e_t>
 void SimObj::ReadSrcProperty<v_t, e_t>::tick() {
   this->_tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
     case OP_WAIT : {
-      if(_ready && !_process->empty()) {
-        // Dequeue from the work queue
-        _data.vertex_id = _process->front();
-        _process->pop_front();
+      // Dequeue from the shared work queue, or this pipeline's frontier
+      bool dequeued = false;
+      if(_ready && _stream != NULL) {
+        // The functional engine already read the property
+        vertex_event_t<v_t> event;
+        dequeued = _stream->pop_vertex(event);
+        _data.vertex_id = event.vertex_id;
+        _data.edge_id = event.edge_begin;
+        _data.vertex_data = event.data;
+      }
+      else if(_ready) {
+        if(_frontier != NULL) {
+          frontier_item_t item;
+          dequeued = _frontier->pop(_pipeline_id, item);
+          _data.vertex_id = item.vertex_id;
+          _data.edge_id = item.edge_start;
+        }
+        else {
+          dequeued = _process->pop(_data.vertex_id);
+          _data.edge_id = _graph->getEdgeBegin(_data.vertex_id);
+        }
+      }
+      if(dequeued) {
+        // edge_id carries the first edge of the (chunk of the) edge list
         _data.vertex_id_addr = _graph->getVertexAddress(_data.vertex_id);
-        _data.vertex_data = _graph->getVertexProperty(_data.vertex_id);
-        _data.edge_id = 0;
-        _items_processed++;
+        if(_stream == NULL) {
+          _data.vertex_data = _graph->getVertexProperty(_data.vertex_id);
+        }
+        // Chunks of a split vertex count as one item
+        if(_data.edge_id == (uint64_t)_graph->getEdgeBegin(_data.vertex_id)) {
+          _items_processed++;
+        }
 
-        if(_process->empty()) {
+        if(_stream != NULL) {
+          // The end of the stream is only seen by the next pop
+          _data.last_vertex = false;
+        }
+        else if((_frontier != NULL) ? _frontier->empty() : _process->isEmpty()) {
           _data.last_vertex = true;
           _ready = false;
         }
@@ -70,41 +122,66 @@ void SimObj::ReadSrcProperty<v_t, e_t>::tick() {
           _data.last_vertex = false;
         }
 
-        _mem_flag = false;
-        _dram->read(_data.vertex_id_addr, &_mem_flag);
-        _stall = STALL_MEM;
-        next_state = OP_MEM_WAIT;
+        _dram->read(_data.vertex_id_addr, _slots.issue(_data));
+      }
+      else if(_ready && _frontier != NULL && _frontier->steal(_pipeline_id) > 0) {
+        // Own queue ran dry, a batch was stolen from a busy pipeline
+        _counter = 0;
+        _has_work = true;
+        _stall = STALL_PROCESSING;
+        next_state = OP_STEAL_WAIT;
       }
       else {
-        next_state = OP_WAIT;
-        _stall = STALL_CAN_ACCEPT;
-        _has_work = false;
+        if(_stream != NULL) {
+          _ready = false;
+        }
       }
       break;
     }
-    case OP_MEM_WAIT : {
-      if(_mem_flag) {
-        if(_next->is_stalled() == STALL_CAN_ACCEPT) {
-          _next->ready(_data);
-          _stall = STALL_CAN_ACCEPT;
-          next_state = OP_WAIT;
-          _has_work = false;
-        }
-        else {
-          next_state = OP_MEM_WAIT;
-          _stall = STALL_PIPE;
-        }
+    case OP_STEAL_WAIT : {
+      if(_counter < _frontier->get_steal_latency()) {
+        _counter++;
+        _stall = STALL_PROCESSING;
+        next_state = OP_STEAL_WAIT;
       }
       else {
-        next_state = OP_MEM_WAIT;
-        _stall = STALL_MEM;
+        _stall = STALL_CAN_ACCEPT;
+        next_state = OP_WAIT;
       }
       break;
     }
+    case OP_MEM_WAIT : {
+      // Every slot has a read in flight
+      break;
+    }
     default : {
 
     }
   }
+
+  // Send the next completed read downstream
+  Utility::pipeline_data<v_t, e_t>* done = _slots.peek();
+  bool blocked = false;
+  if(done != NULL) {
+    if(_next->is_stalled() == STALL_CAN_ACCEPT) {
+      _next->ready(*done);
+      _slots.pop();
+    }
+    else {
+      blocked = true;
+    }
+  }
+  if(next_state != OP_STEAL_WAIT) {
+    if(_slots.full()) {
+      next_state = OP_MEM_WAIT;
+      _stall = blocked ? STALL_PIPE : STALL_MEM;
+    }
+    else {
+      next_state = OP_WAIT;
+      _stall = STALL_CAN_ACCEPT;
+    }
+    _has_work = !_slots.empty();
+  }
 #if 0
   if(_state != next_state) {
     std::cout << "[ " << __PRETTY_FUNCTION__ << " ] tick: " << this->_tick << "  state: " << _state_name[_state] << "  next_state: " << _state_name[next_state] << "\n";
@@ -113,3 +190,13 @@ void SimObj::ReadSrcProperty<v_t, e_t>::tick() {
   _state = next_state;
   this->update_stats();
 }
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcProperty<v_t, e_t>::set_request_slots(uint64_t num_slots, bool in_order) {
+  _slots = RequestSlots<Utility::pipeline_data<v_t, e_t>>(num_slots, in_order);
+}
+
+template<class v_t, class e_t>
+void SimObj::ReadSrcProperty<v_t, e_t>::set_stream(FunctionalStream<v_t, e_t>* stream) {
+  _stream = stream;
+}
@@ -46,7 +46,7 @@ SimObj::ReadTempDstProperty<v_t, e_t>::~ReadTempDstProperty() {
 template<class v_t, class e_t>
 void SimObj::ReadTempDstProperty<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -58,7 +58,7 @@ void SimObj::ReadTempDstProperty<v_t, e_t>::tick(void) {
 #endif
         _ready = false;
         _mem_flag = false;
-        _scratchpad->read(0x01, &_mem_flag);
+        _scratchpad->read(_graph->getTempVertexAddress(_data.vertex_dst_id), &_mem_flag);
         _stall = STALL_MEM;
         next_state = OP_MEM_WAIT;
       }
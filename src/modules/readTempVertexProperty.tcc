@@ -43,7 +43,7 @@ SimObj::ReadTempVertexProperty<v_t, e_t>::~ReadTempVertexProperty() {
 template<class v_t, class e_t>
 void SimObj::ReadTempVertexProperty<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -52,7 +52,7 @@ void SimObj::ReadTempVertexProperty<v_t, e_t>::tick(void) {
         // Upstream sent vertex & vertex property
         _ready = false;
         _mem_flag = false;
-        _dram->read(0x01, &_mem_flag);
+        _dram->read(_graph->getTempVertexAddress(_data.vertex_id), &_mem_flag);
         _stall = STALL_MEM;
         next_state = OP_MEM_WAIT;
       }
@@ -17,6 +17,7 @@
 
 #include "module.h"
 #include "memory.h"
+#include "requestSlots.h"
 
 namespace SimObj {
 
@@ -49,14 +50,15 @@ private:
   op_t _state;
   std::list<uint64_t>* _apply;
   Utility::readGraph<v_t>* _graph;
+  RequestSlots<Utility::pipeline_data<v_t, e_t>> _slots; // Reads in flight
 
 public:
-  bool _mem_flag;
   ReadVertexProperty();
   ReadVertexProperty(Memory* dram, std::list<uint64_t>* apply, Utility::readGraph<v_t>* graph);
   ~ReadVertexProperty();
 
   void tick(void);
+  void set_request_slots(uint64_t num_slots, bool in_order);
 };
 
 } // namespace SimObj
@@ -13,7 +13,6 @@ SimObj::ReadVertexProperty<v_t, e_t>::ReadVertexProperty() {
   _apply = NULL;
   _graph = NULL;
   _ready = false;
-  _mem_flag = false;
   _state = OP_WAIT;
 }
 
@@ -27,7 +26,6 @@ SimObj::ReadVertexProperty<v_t, e_t>::ReadVertexProperty(Memory* dram, std::list
   _graph = graph;
   _dram = dram;
   _ready = false;
-  _mem_flag = false;
   _state = OP_WAIT;
 }
 
@@ -40,10 +38,16 @@ SimObj::ReadVertexProperty<v_t, e_t>::~ReadVertexProperty() {
 }
 
 
+template<class v_t, class e_t>
+void SimObj::ReadVertexProperty<v_t, e_t>::set_request_slots(uint64_t num_slots, bool in_order) {
+  _slots = RequestSlots<Utility::pipeline_data<v_t, e_t>>(num_slots, in_order);
+}
+
+
 template<class v_t, class e_t>
 void SimObj::ReadVertexProperty<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -51,7 +55,7 @@ void SimObj::ReadVertexProperty<v_t, e_t>::tick(void) {
       if(_ready && !_apply->empty()) {
         // Dequeue from the apply work queue
         _data.vertex_id = _apply->front();
-        _data.vertex_id_addr = _graph->getVertexAddress(_data.vertex_id_addr);
+        _data.vertex_id_addr = _graph->getVertexAddress(_data.vertex_id);
         _apply->pop_front();
         _data.last_edge = false;
         _data.last_vertex = false;
@@ -64,42 +68,40 @@ void SimObj::ReadVertexProperty<v_t, e_t>::tick(void) {
 
         // Read the global vertex property
         _data.vertex_data = _graph->getVertexProperty(_data.vertex_id);
-        _mem_flag = false;
-        _dram->read(_data.vertex_id_addr, &_mem_flag);
-        _stall = STALL_MEM;
-        next_state = OP_MEM_WAIT;
-      }
-      else {
-        // Wait for upstream to send vertex
-        next_state = OP_WAIT;
-        _stall = STALL_CAN_ACCEPT;
-        _has_work = false;
+        _dram->read(_data.vertex_id_addr, _slots.issue(_data));
       }
       break;
     }
     case OP_MEM_WAIT : {
-      if(_mem_flag) {
-        if(_next->is_stalled() == STALL_CAN_ACCEPT) {
-          _next->ready(_data);
-          next_state = OP_WAIT;
-          _stall = STALL_CAN_ACCEPT;
-          _has_work = false;
-        }
-        else {
-          next_state = OP_MEM_WAIT;
-          _stall = STALL_PIPE;
-        }
-      }
-      else {
-        next_state = OP_MEM_WAIT;
-        _stall = STALL_MEM;
-      }
+      // Every slot has a read in flight
       break;
     }
     default : {
 
     }
   }
+
+  // Send the next completed read downstream
+  Utility::pipeline_data<v_t, e_t>* done = _slots.peek();
+  bool blocked = false;
+  if(done != NULL) {
+    if(_next->is_stalled() == STALL_CAN_ACCEPT) {
+      _next->ready(*done);
+      _slots.pop();
+    }
+    else {
+      blocked = true;
+    }
+  }
+  if(_slots.full()) {
+    next_state = OP_MEM_WAIT;
+    _stall = blocked ? STALL_PIPE : STALL_MEM;
+  }
+  else {
+    next_state = OP_WAIT;
+    _stall = STALL_CAN_ACCEPT;
+  }
+  _has_work = !_slots.empty();
 #if 0
   if(_state != next_state) {
     std::cout << "[ " << __PRETTY_FUNCTION__ << " ] tick: " << _tick << "  state: " << _state_name[_state] << "  next_state: " << _state_name[next_state] << "\n";
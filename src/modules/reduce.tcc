@@ -40,7 +40,7 @@ SimObj::Reduce<v_t, e_t>::~Reduce() {
 template<class v_t, class e_t>
 void SimObj::Reduce<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
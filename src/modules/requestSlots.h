@@ -0,0 +1,57 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Request Slots:
+ *  MSHR-like table of the reads a pipeline stage has in flight. Each slot
+ *  holds the item waiting on the read and the completion flag handed to the
+ *  memory. Items leave in issue order, or out of order as soon as their read
+ *  completes, the oldest completed one first.
+ *
+ */
+
+#ifndef REQUEST_SLOTS_H
+#define REQUEST_SLOTS_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SimObj {
+
+template<class T>
+class RequestSlots {
+private:
+  struct slot_t {
+    T data;
+    bool complete;
+  };
+
+  // Fixed size, the memories hold pointers to the flags
+  std::vector<slot_t> _slots;
+  std::vector<uint64_t> _free;
+  std::deque<uint64_t> _order; // Occupied slots, oldest first
+  bool _in_order;
+
+public:
+  RequestSlots();
+  RequestSlots(uint64_t num_slots, bool in_order);
+  ~RequestSlots();
+
+  // Claim a slot for data, returns the flag the memory sets on completion
+  bool* issue(const T& data);
+
+  // Next item allowed to leave, NULL until its read has completed
+  T* peek(void);
+  // Free the slot returned by peek
+  void pop(void);
+
+  bool full(void);
+  bool empty(void);
+};
+
+} // namespace SimObj
+
+#include "requestSlots.tcc"
+
+#endif
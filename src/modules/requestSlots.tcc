@@ -0,0 +1,75 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Request Slots:
+ *  MSHR-like table of the reads a pipeline stage has in flight.
+ *
+ */
+
+#include <cassert>
+
+template<class T>
+SimObj::RequestSlots<T>::RequestSlots() : RequestSlots(1, true) {
+}
+
+template<class T>
+SimObj::RequestSlots<T>::RequestSlots(uint64_t num_slots, bool in_order) {
+  assert(num_slots > 0);
+  _slots.resize(num_slots);
+  for(uint64_t i = num_slots; i > 0; i--) {
+    _free.push_back(i - 1);
+  }
+  _in_order = in_order;
+}
+
+template<class T>
+SimObj::RequestSlots<T>::~RequestSlots() {
+}
+
+template<class T>
+bool* SimObj::RequestSlots<T>::issue(const T& data) {
+  assert(!full());
+  uint64_t slot = _free.back();
+  _free.pop_back();
+  _slots[slot].data = data;
+  _slots[slot].complete = false;
+  _order.push_back(slot);
+  return &_slots[slot].complete;
+}
+
+template<class T>
+T* SimObj::RequestSlots<T>::peek(void) {
+  for(auto & slot : _order) {
+    if(_slots[slot].complete) {
+      return &_slots[slot].data;
+    }
+    if(_in_order) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+template<class T>
+void SimObj::RequestSlots<T>::pop(void) {
+  for(auto it = _order.begin(); it != _order.end(); it++) {
+    if(_slots[*it].complete) {
+      _free.push_back(*it);
+      _order.erase(it);
+      return;
+    }
+    assert(!_in_order);
+  }
+  assert(false);
+}
+
+template<class T>
+bool SimObj::RequestSlots<T>::full(void) {
+  return _free.empty();
+}
+
+template<class T>
+bool SimObj::RequestSlots<T>::empty(void) {
+  return _order.empty();
+}
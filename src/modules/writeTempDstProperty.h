@@ -51,6 +51,7 @@ private:
   Memory* _scratchpad;
   op_t _state;
   ControlAtomicUpdate<v_t, e_t>* _cau;
+  Utility::readGraph<v_t>* _graph;
 
   std::map<uint64_t, Utility::pipeline_data<v_t, e_t>>* _scratch_mem;
   std::list<uint64_t>* _apply;
@@ -60,7 +61,7 @@ private:
 public:
   bool _mem_flag;
   WriteTempDstProperty();
-  WriteTempDstProperty(Memory* scratchpad, ControlAtomicUpdate<v_t, e_t>* cau, std::map<uint64_t, Utility::pipeline_data<v_t, e_t>>* scratch_mem, std::list<uint64_t>* apply);
+  WriteTempDstProperty(Memory* scratchpad, Utility::readGraph<v_t>* graph, ControlAtomicUpdate<v_t, e_t>* cau, std::map<uint64_t, Utility::pipeline_data<v_t, e_t>>* scratch_mem, std::list<uint64_t>* apply);
   ~WriteTempDstProperty();
 
   void tick(void);
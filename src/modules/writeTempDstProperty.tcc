@@ -11,6 +11,7 @@
 template<class v_t, class e_t>
 SimObj::WriteTempDstProperty<v_t, e_t>::WriteTempDstProperty() {
   _scratchpad = NULL;
+  _graph = NULL;
   _scratch_mem = NULL;
   _cau = NULL;
   _apply = NULL;
@@ -21,13 +22,15 @@ SimObj::WriteTempDstProperty<v_t, e_t>::WriteTempDstProperty() {
 
 
 template<class v_t, class e_t>
-SimObj::WriteTempDstProperty<v_t, e_t>::WriteTempDstProperty(Memory* scratchpad, ControlAtomicUpdate<v_t, e_t>* cau, std::map<uint64_t, Utility::pipeline_data<v_t, e_t>>* scratch_mem, std::list<uint64_t>* apply) {
+SimObj::WriteTempDstProperty<v_t, e_t>::WriteTempDstProperty(Memory* scratchpad, Utility::readGraph<v_t>* graph, ControlAtomicUpdate<v_t, e_t>* cau, std::map<uint64_t, Utility::pipeline_data<v_t, e_t>>* scratch_mem, std::list<uint64_t>* apply) {
   assert(scratchpad != NULL);
+  assert(graph != NULL);
   assert(cau != NULL);
   assert(scratch_mem != NULL);
   assert(apply != NULL);
   _apply = apply;
   _scratchpad = scratchpad;
+  _graph = graph;
   _cau = cau;
   _scratch_mem = scratch_mem;
   _ready = false;
@@ -40,6 +43,7 @@ SimObj::WriteTempDstProperty<v_t, e_t>::WriteTempDstProperty(Memory* scratchpad,
 template<class v_t, class e_t>
 SimObj::WriteTempDstProperty<v_t, e_t>::~WriteTempDstProperty() {
   _scratchpad = NULL;
+  _graph = NULL;
   _scratch_mem = NULL;
   _cau = NULL;
   _apply = NULL;
@@ -49,7 +53,7 @@ SimObj::WriteTempDstProperty<v_t, e_t>::~WriteTempDstProperty() {
 template<class v_t, class e_t>
 void SimObj::WriteTempDstProperty<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -60,7 +64,7 @@ void SimObj::WriteTempDstProperty<v_t, e_t>::tick(void) {
 #endif
         _ready = false;
         _mem_flag = false;
-        _scratchpad->write(0x01, &_mem_flag);
+        _scratchpad->write(_graph->getTempVertexAddress(_data.vertex_dst_id), &_mem_flag);
         _stall = STALL_MEM;
         next_state = OP_MEM_WAIT;
       }
@@ -77,12 +81,7 @@ void SimObj::WriteTempDstProperty<v_t, e_t>::tick(void) {
         _scratch_mem->insert_or_assign(_data.vertex_dst_id, _data);
         _apply->push_back(_data.vertex_dst_id);
         _edges_written++;
-        Utility::pipeline_data<v_t, e_t> temp_data = _cau->signal();
-#ifdef DEBUG
-        assert(temp_data.vertex_id == _data.vertex_id);
-        assert(temp_data.edge_id == _data.edge_id);
-        assert(temp_data.vertex_dst_id == _data.vertex_dst_id);
-#endif
+        _cau->signal(_data.vertex_dst_id);
         next_state = OP_WAIT;
         _stall = STALL_CAN_ACCEPT;
         _has_work = false;
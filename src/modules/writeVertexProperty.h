@@ -14,10 +14,10 @@
 #include <vector>
 #include <cstdint>
 #include <map>
-#include <list>
 
 #include "module.h"
 #include "memory.h"
+#include "atomicQueue.h"
 #include "log.h"
 
 #include "readGraph.h"
@@ -54,12 +54,12 @@ private:
   uint64_t _throughput;
 
   Utility::readGraph<v_t>* _graph;
-  std::list<uint64_t>* _process;
+  Utility::AtomicQueue<uint64_t>* _process;
 
 public:
   bool _mem_flag;
   WriteVertexProperty();
-  WriteVertexProperty(Memory* dram, std::list<uint64_t>* process, Utility::readGraph<v_t>* graph);
+  WriteVertexProperty(Memory* dram, Utility::AtomicQueue<uint64_t>* process, Utility::readGraph<v_t>* graph);
   ~WriteVertexProperty();
 
   void tick(void);
@@ -8,6 +8,7 @@
  */
 
 #include <cassert>
+#include <stdexcept>
 
 
 template<class v_t, class e_t>
@@ -23,7 +24,7 @@ SimObj::WriteVertexProperty<v_t, e_t>::WriteVertexProperty() {
 
 
 template<class v_t, class e_t>
-SimObj::WriteVertexProperty<v_t, e_t>::WriteVertexProperty(Memory* dram, std::list<uint64_t>* process, Utility::readGraph<v_t>* graph) {
+SimObj::WriteVertexProperty<v_t, e_t>::WriteVertexProperty(Memory* dram, Utility::AtomicQueue<uint64_t>* process, Utility::readGraph<v_t>* graph) {
   assert(dram != NULL);
   assert(graph != NULL);
   assert(process != NULL);
@@ -48,7 +49,7 @@ SimObj::WriteVertexProperty<v_t, e_t>::~WriteVertexProperty() {
 template<class v_t, class e_t>
 void SimObj::WriteVertexProperty<v_t, e_t>::tick(void) {
   _tick++;
-  op_t next_state;
+  op_t next_state = _state;
 
   // Module State Machine
   switch(_state) {
@@ -74,7 +75,10 @@ void SimObj::WriteVertexProperty<v_t, e_t>::tick(void) {
         // Write to global mem
         if(_data.updated) {
           _graph->setVertexProperty(_data.vertex_id, _data.vertex_data);
-          _process->push_back(_data.vertex_id);
+          if(!_process->push(_data.vertex_id)) {
+            // Dropping the vertex would silently lose it from the next iteration
+            throw std::runtime_error(_name + ": frontier queue is full, increase --frontier_capacity");
+          }
           _throughput++;
         }
         next_state = OP_WAIT;
@@ -0,0 +1,134 @@
+/*
+ * Andrew Smith
+ *
+ * DRAM Compare:
+ *  Sanity check of the banked DRAM model. Runs the same synthetic request
+ *  streams through the simple, banked and, in a DRAMSIM2 build, DRAMSim2
+ *  models and prints the cycles each takes to drain them. Fails if a
+ *  banked stream does not drain, or if a lone read or write to a closed
+ *  row does not take the 1 + tRCD + RL or WL + BL/2 cycles of the device
+ *  .ini.
+ *
+ *  make dram_compare
+ *  ./dram_compare --dram_ini=./modules/memory/DDR3_micron_64M_8B_x4_sg15.ini
+ *
+ */
+
+#include <iostream>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "memory.h"
+#include "simpleDram.h"
+#include "bankedDram.h"
+#include "dram.h"
+#include "iniReader.h"
+
+#include "option.h"
+
+// Requests per stream, and ticks per request before a stream counts as hung
+#define STREAM_REQUESTS 4096
+#define HANG_TICKS 1000
+
+SimObj::Memory* new_model(const std::string& model, const Utility::Options& opt) {
+  if(model == "banked") {
+    return new SimObj::BankedDRAM(opt.dram_ini, opt.dram_system_ini, opt.dram_megs);
+  }
+#ifdef DRAMSIM2
+  if(model == "dramsim2") {
+    return new SimObj::DRAM(opt.dram_ini, opt.dram_system_ini, opt.dram_megs);
+  }
+#endif
+  return new SimObj::SimpleDRAM(opt.dram_read_latency, opt.dram_write_latency, opt.dram_num_simultaneous_requests, opt.dram_data_width, opt.dram_bandwidth);
+}
+
+// Ticks to complete addrs with at most window requests in flight, 0 if hung
+uint64_t run_stream(SimObj::Memory* mem, const std::vector<uint64_t>& addrs, bool write, uint64_t window) {
+  std::vector<bool*> complete;
+  uint64_t issued = 0;
+  uint64_t done = 0;
+  uint64_t tick = 0;
+  uint64_t limit = (addrs.size() + 1) * HANG_TICKS;
+  while(done < addrs.size()) {
+    while(issued < addrs.size() && issued - done < window) {
+      complete.push_back(new bool(false));
+      if(write) {
+        mem->write(addrs[issued], complete.back());
+      }
+      else {
+        mem->read(addrs[issued], complete.back());
+      }
+      issued++;
+    }
+    mem->tick();
+    tick++;
+    done = 0;
+    for(auto flag : complete) {
+      done += *flag;
+    }
+    if(tick > limit) {
+      tick = 0;
+      break;
+    }
+  }
+  for(auto flag : complete) {
+    delete flag;
+  }
+  return tick;
+}
+
+int main(int argc, char** argv) {
+  Utility::Options opt;
+  opt.parse(argc, argv);
+
+  std::vector<std::string> models = {"simple", "banked"};
+#ifdef DRAMSIM2
+  models.push_back("dramsim2");
+#endif
+
+  // Sequential lines, and lines spread over the whole capacity
+  std::vector<uint64_t> sequential;
+  std::vector<uint64_t> random;
+  uint64_t lines = (opt.dram_megs << 20) / opt.dram_data_width;
+  uint64_t seed = 1;
+  for(uint64_t i = 0; i < STREAM_REQUESTS; i++) {
+    sequential.push_back(i * opt.dram_data_width);
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    random.push_back((seed >> 16) % lines * opt.dram_data_width);
+  }
+
+  bool failed = false;
+  for(auto & model : models) {
+    for(int write = 0; write < 2; write++) {
+      for(int pattern = 0; pattern < 2; pattern++) {
+        SimObj::Memory* mem = new_model(model, opt);
+        uint64_t ticks = run_stream(mem, pattern ? random : sequential, write, opt.dram_num_simultaneous_requests);
+        delete mem;
+        std::cout << "DramCompare," << model << "," << (write ? "write" : "read") << "," << (pattern ? "random" : "sequential")
+                  << ",requests," << STREAM_REQUESTS << ",ticks," << ticks << "\n";
+        if(ticks == 0) {
+          std::cerr << "dram_compare: " << model << " did not drain the stream\n";
+          failed |= model == "banked";
+        }
+      }
+    }
+  }
+
+  // A lone request to a closed row: activate, column command, then the burst
+  Utility::IniReader device(opt.dram_ini);
+  uint64_t read_latency = device.get_uint("CL", 10) + device.get_uint("AL", 0);
+  uint64_t write_latency = device.get_uint("WL", read_latency > 0 ? read_latency - 1 : 0);
+  for(int write = 0; write < 2; write++) {
+    SimObj::Memory* mem = new_model("banked", opt);
+    uint64_t ticks = run_stream(mem, std::vector<uint64_t>(1, 0), write, 1);
+    delete mem;
+    uint64_t expected = 1 + device.get_uint("tRCD", 10) + (write ? write_latency : read_latency) + device.get_uint("BL", 8) / 2;
+    std::cout << "DramCompare,banked," << (write ? "write" : "read") << ",closed_row,ticks," << ticks << ",expected," << expected << "\n";
+    if(ticks != expected) {
+      std::cerr << "dram_compare: banked " << (write ? "write" : "read") << " took " << ticks << " ticks, expected " << expected << "\n";
+      failed = true;
+    }
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Andrew Smith
+ *
+ * Trace Replay:
+ *  Feeds a memory trace written by g_sim --trace into the memory system
+ *  selected by the usual options (--dram_model, --cache_*, --prefetch_*,
+ *  --coalesce) without simulating the pipelines. Requests issue at their
+ *  recorded tick, so the access stream is the same for every memory
+ *  configuration; each pipeline gets its own cache and stream prefetcher
+ *  as in g_sim. The memory is a single channel, traces of runs with
+ *  --mem_channels > 1 are rejected.
+ *
+ *  make replay
+ *  ./replay --trace=run.trace --dram_model=banked --cache_capacity=32768
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <list>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "memory.h"
+#include "memoryModel.h"
+#include "cache.h"
+#include "streamPrefetcher.h"
+#include "coalescer.h"
+#include "log.h"
+
+#include "option.h"
+#include "clockDomain.h"
+#include "trace.h"
+
+struct source_t {
+  SimObj::Memory* mem;
+  uint64_t requests;
+  uint64_t latency;
+};
+
+// Pipeline number at the end of a source name, "ReadDstProperty 3" -> 3
+uint64_t source_pipeline(const std::string& name) {
+  size_t space = name.find_last_of(' ');
+  return space == std::string::npos ? 0 : std::stoull(name.substr(space + 1));
+}
+
+int main(int argc, char** argv) {
+  Utility::Options opt;
+  opt.parse(argc, argv);
+  if(opt.trace.empty()) {
+    std::cerr << "replay: --trace is required\n";
+    return 1;
+  }
+  if(opt.mem_channels != 1) {
+    std::cerr << "replay: --mem_channels is not supported, replay models a single channel\n";
+    return 1;
+  }
+  Utility::TraceReader reader(opt.trace);
+
+  SimObj::Memory* mem = SimObj::new_memory(opt);
+  SimObj::Coalescer* coalescer = NULL;
+  SimObj::Memory* front = mem;
+  if(opt.coalesce) {
+    coalescer = new SimObj::Coalescer(mem, opt.dram_data_width);
+    front = coalescer;
+  }
+  Utility::ClockDomain dram_clock(SimObj::dram_clock_khz(opt), opt.pipeline_clock * 1000);
+
+  // Per-pipeline caches and prefetchers, built as sources show up
+  std::map<uint64_t, SimObj::Cache*> cache;
+  std::map<uint64_t, SimObj::StreamPrefetcher*> prefetcher;
+  std::vector<source_t> sources;
+
+  // complete, issue tick, source
+  std::list<std::tuple<bool*, uint64_t, uint64_t>> outstanding;
+  Utility::trace_record_t record;
+  bool have_record = reader.next(record);
+  if(reader.get_channels() != 1) {
+    std::cerr << "replay: " << opt.trace << " is from a run with " << reader.get_channels() << " memory channels, replay models a single channel\n";
+    return 1;
+  }
+  uint64_t tick = 0;
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+
+  while(have_record || !outstanding.empty()) {
+    if(outstanding.empty() && record.tick > tick + 1) {
+      // Nothing in flight, skip ahead to the next request
+      tick = record.tick - 1;
+    }
+    tick++;
+    while(have_record && record.tick <= tick) {
+      while(sources.size() < reader.get_num_sources()) {
+        const std::string& name = reader.get_source(sources.size());
+        uint64_t pipeline = source_pipeline(name);
+        // Same wiring as Pipeline: the cache sits in front of the prefetcher
+        SimObj::Memory* stream_mem = front;
+        if(opt.prefetch_depth != 0) {
+          if(prefetcher.count(pipeline) == 0) {
+            prefetcher[pipeline] = new SimObj::StreamPrefetcher(front, opt.prefetch_streams, opt.prefetch_depth, opt.prefetch_line, opt.prefetch_hit_latency);
+            prefetcher[pipeline]->set_name("StreamPrefetcher " + std::to_string(pipeline));
+          }
+          stream_mem = prefetcher[pipeline];
+        }
+        // The indirect prefetcher reads destinations through the same port
+        bool dst_reads = name.rfind("ReadDstProperty", 0) == 0 || name.rfind("IndirectPrefetcher", 0) == 0;
+        bool vertex_writes = name.rfind("WriteVertexProperty", 0) == 0;
+        SimObj::Memory* source_mem = dst_reads ? front : stream_mem;
+        if((dst_reads || vertex_writes) && opt.cache_capacity != 0) {
+          if(cache.count(pipeline) == 0) {
+            cache[pipeline] = new SimObj::Cache(stream_mem, opt.cache_capacity, opt.cache_ways, opt.cache_line,
+                                                SimObj::replacement_from_string(opt.cache_replacement), opt.cache_mshrs,
+                                                SimObj::write_policy_from_string(opt.cache_write_policy), opt.cache_hit_latency);
+            cache[pipeline]->set_name("Cache " + std::to_string(pipeline));
+          }
+          source_mem = cache[pipeline];
+        }
+        sources.push_back({source_mem, 0, 0});
+      }
+      bool* complete = new bool(false);
+      if(record.write) {
+        sources[record.source].mem->write(record.addr, complete, record.sequential);
+        writes++;
+      }
+      else {
+        sources[record.source].mem->read(record.addr, complete, record.sequential);
+        reads++;
+      }
+      outstanding.emplace_back(complete, tick, record.source);
+      have_record = reader.next(record);
+    }
+
+    for(auto & element : cache) element.second->tick();
+    for(auto & element : prefetcher) element.second->tick();
+    for(uint64_t i = dram_clock.advance(); i > 0; i--) {
+      mem->tick();
+    }
+    if(coalescer) coalescer->tick();
+
+    for(auto it = outstanding.begin(); it != outstanding.end();) {
+      if(*std::get<0>(*it)) {
+        source_t& source = sources[std::get<2>(*it)];
+        source.requests++;
+        source.latency += tick - std::get<1>(*it);
+        delete std::get<0>(*it);
+        it = outstanding.erase(it);
+      }
+      else {
+        it++;
+      }
+    }
+  }
+
+  uint64_t latency = 0;
+  for(uint64_t i = 0; i < sources.size(); i++) {
+    latency += sources[i].latency;
+    SimObj::sim_out.write("ReplaySource," + reader.get_source(i) +
+                          ",requests," + std::to_string(sources[i].requests) +
+                          ",avg_latency," + std::to_string(sources[i].requests ? (double)sources[i].latency / (double)sources[i].requests : 0.0) + "\n");
+  }
+  SimObj::sim_out.write("Replay,reads," + std::to_string(reads) +
+                        ",writes," + std::to_string(writes) +
+                        ",ticks," + std::to_string(tick) +
+                        ",avg_latency," + std::to_string(reads + writes ? (double)latency / (double)(reads + writes) : 0.0) + "\n");
+  for(auto & element : cache) element.second->print_stats_csv();
+  for(auto & element : prefetcher) element.second->print_stats_csv();
+  if(coalescer) coalescer->print_stats_csv();
+  mem->print_stats_csv();
+  mem->print_stats();
+  std::cout << "Replayed " << reads + writes << " requests in " << tick << " ticks\n";
+
+  for(auto & element : cache) delete element.second;
+  for(auto & element : prefetcher) delete element.second;
+  delete coalescer;
+  delete mem;
+  return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Andrew Smith
+ *
+ * Address Map
+ *
+ */
+
+#include <cassert>
+#include <ios>
+
+#include "addressMap.h"
+
+Utility::AddressMap::AddressMap() : AddressMap(4096) {
+}
+
+Utility::AddressMap::AddressMap(uint64_t alignment) {
+  assert(alignment != 0);
+  _alignment = alignment;
+  _next = 0;
+  for(int i = 0; i < REGION_NUM; i++) {
+    _base[i] = 0;
+    _stride[i] = 0;
+    _count[i] = 0;
+    _valid[i] = false;
+  }
+}
+
+Utility::AddressMap::~AddressMap() {
+  // Do Nothing
+}
+
+void Utility::AddressMap::add_region(region_t region, uint64_t count, uint64_t stride) {
+  assert(region < REGION_NUM);
+  assert(!_valid[region]);
+  assert(stride != 0);
+  _base[region] = _next;
+  _stride[region] = stride;
+  _count[region] = count;
+  _valid[region] = true;
+  // Next region starts on the following alignment boundary
+  _next += ((count * stride + _alignment - 1) / _alignment) * _alignment;
+}
+
+uint64_t Utility::AddressMap::get_address(region_t region, uint64_t index) const {
+  assert(_valid[region]);
+  assert(index < _count[region]);
+  return _base[region] + index * _stride[region];
+}
+
+uint64_t Utility::AddressMap::get_base(region_t region) const {
+  assert(_valid[region]);
+  return _base[region];
+}
+
+uint64_t Utility::AddressMap::get_size(region_t region) const {
+  assert(_valid[region]);
+  return _count[region] * _stride[region];
+}
+
+bool Utility::AddressMap::has_region(region_t region) const {
+  return _valid[region];
+}
+
+void Utility::AddressMap::print(std::ostream& out) const {
+  for(int i = 0; i < REGION_NUM; i++) {
+    if(_valid[i]) {
+      out << region_name((region_t)i) << ": base 0x" << std::hex << _base[i] << std::dec
+          << ", " << _count[i] << " x " << _stride[i] << " bytes\n";
+    }
+  }
+}
+
+std::string Utility::region_name(region_t region) {
+  switch(region) {
+    case REGION_NODE_PTRS : return "node_ptrs";
+    case REGION_NEIGHBORS : return "neighbors";
+    case REGION_EDGE_WEIGHTS : return "edge_weights";
+    case REGION_VERTEX_PROPERTY : return "vertex_property";
+    case REGION_TEMP_PROPERTY : return "temp_property";
+    default : return "unknown";
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Andrew Smith
+ *
+ * Address Map:
+ *  Assigns simulated base addresses and strides to the graph data
+ *  structures so the memory models see a fixed layout instead of host
+ *  pointers. Each region starts on an alignment boundary (a DRAM row by
+ *  default) after the previous one.
+ *
+ */
+
+#ifndef ADDRESS_MAP_H
+#define ADDRESS_MAP_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace Utility {
+
+enum region_t {
+  REGION_NODE_PTRS,       // CSR offsets
+  REGION_NEIGHBORS,       // CSR neighbor ids
+  REGION_EDGE_WEIGHTS,
+  REGION_VERTEX_PROPERTY,
+  REGION_TEMP_PROPERTY,   // Scratchpad address space
+  REGION_NUM
+};
+
+class AddressMap {
+private:
+  uint64_t _alignment;
+  uint64_t _next;
+  uint64_t _base[REGION_NUM];
+  uint64_t _stride[REGION_NUM];
+  uint64_t _count[REGION_NUM];
+  bool _valid[REGION_NUM];
+
+public:
+  AddressMap(void);
+  AddressMap(uint64_t alignment);
+  ~AddressMap();
+
+  // Place count elements of stride bytes after the previous region
+  void add_region(region_t region, uint64_t count, uint64_t stride);
+  uint64_t get_address(region_t region, uint64_t index) const;
+  uint64_t get_base(region_t region) const;
+  uint64_t get_size(region_t region) const;
+  bool has_region(region_t region) const;
+
+  void print(std::ostream& out) const;
+};
+
+std::string region_name(region_t region);
+
+}; // namespace Utility
+
+#endif // ADDRESS_MAP_H
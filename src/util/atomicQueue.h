@@ -3,39 +3,58 @@
  * Andrew Smith
  * 
  * Global frontier queue
+ *  Bounded lock-free multi-producer/multi-consumer queue (Vyukov style).
+ *  Every cell carries a sequence number that tells producers and consumers
+ *  whether it is free to write or ready to read, so pipelines on different
+ *  threads can publish and take active vertices without a lock.
  *
  */
 
 #ifndef ATOMIC_QUEUE_H
 #define ATOMIC_QUEUE_H
 
-#include <queue>
-#include <pthread.h>
+#include <atomic>
+#include <cstdint>
 
 namespace Utility {
 
 template<class T>
 class AtomicQueue {
 private:
-  std::queue<T> _queue;
-  pthread_mutex_t _queue_mutex;
+  struct cell_t {
+    std::atomic<uint64_t> sequence;
+    T data;
+  };
+
+  cell_t* _buffer;
+  uint64_t _capacity;
+
+  // Kept on separate cache lines, producers and consumers do not false-share
+  alignas(64) std::atomic<uint64_t> _enqueue_pos;
+  alignas(64) std::atomic<uint64_t> _dequeue_pos;
 
 public:
   // Constructor
-  AtomicQueue() { _queue_mutex = PTHREAD_MUTEX_INITIALIZER; }
+  AtomicQueue(uint64_t capacity);
 
   // Destructor
-  ~AtomicQueue() { /* Do Nothing */ }
+  ~AtomicQueue();
 
-  // Push
-  void push(const T obj);
+  AtomicQueue(const AtomicQueue&) = delete;
+  AtomicQueue& operator=(const AtomicQueue&) = delete;
 
-  // Pop
-  T pop();
+  // Push, returns false if the queue is full
+  bool push(const T& obj);
 
-  // Size
+  // Pop, returns false if the queue is empty
+  bool pop(T& obj);
+
+  // Size, exact only when no push or pop is in flight
   uint64_t size();
 
+  // Capacity
+  uint64_t capacity();
+
   // IsEmpty
   bool isEmpty();
 
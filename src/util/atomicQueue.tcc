@@ -1,8 +1,102 @@
+/*
+ *
+ * Andrew Smith
+ * 
+ * Global frontier queue
+ *
+ */
+
+#include <cassert>
+#include <cstddef>
+
+template<class T>
+Utility::AtomicQueue<T>::AtomicQueue(uint64_t capacity) {
+  assert(capacity > 0);
+  _capacity = capacity;
+  _buffer = new cell_t[capacity];
+  for(uint64_t i = 0; i < capacity; i++) {
+    _buffer[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  _enqueue_pos.store(0, std::memory_order_relaxed);
+  _dequeue_pos.store(0, std::memory_order_relaxed);
+}
+
+template<class T>
+Utility::AtomicQueue<T>::~AtomicQueue() {
+  delete[] _buffer;
+  _buffer = NULL;
+}
+
+template<class T>
+bool Utility::AtomicQueue<T>::push(const T& obj) {
+  cell_t* cell;
+  uint64_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+  while(true) {
+    cell = &_buffer[pos % _capacity];
+    uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+    int64_t diff = (int64_t)seq - (int64_t)pos;
+    if(diff == 0) {
+      // Cell is free, try to claim it
+      if(_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    else if(diff < 0) {
+      // Cell still holds an unread element from the previous lap: full
+      return false;
+    }
+    else {
+      // Another producer claimed it first
+      pos = _enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+  cell->data = obj;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
 template<class T>
-void Utility::AtomicQueue<T>::push(const T obj) {
-  pthread_mutex_lock(&this->_queue_mutex);
-  _queue.push(obj);
-  pthread_mutex_unlock(&this->_queue_mutex);
+bool Utility::AtomicQueue<T>::pop(T& obj) {
+  cell_t* cell;
+  uint64_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+  while(true) {
+    cell = &_buffer[pos % _capacity];
+    uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+    int64_t diff = (int64_t)seq - (int64_t)(pos + 1);
+    if(diff == 0) {
+      // Cell holds data, try to claim it
+      if(_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    else if(diff < 0) {
+      // Nothing written here yet: empty
+      return false;
+    }
+    else {
+      // Another consumer claimed it first
+      pos = _dequeue_pos.load(std::memory_order_relaxed);
+    }
+  }
+  obj = cell->data;
+  // Hand the cell back to producers for the next lap
+  cell->sequence.store(pos + _capacity, std::memory_order_release);
+  return true;
 }
 
+template<class T>
+uint64_t Utility::AtomicQueue<T>::size() {
+  uint64_t head = _dequeue_pos.load(std::memory_order_acquire);
+  uint64_t tail = _enqueue_pos.load(std::memory_order_acquire);
+  return (tail > head) ? tail - head : 0;
+}
 
+template<class T>
+uint64_t Utility::AtomicQueue<T>::capacity() {
+  return _capacity;
+}
+
+template<class T>
+bool Utility::AtomicQueue<T>::isEmpty() {
+  return size() == 0;
+}
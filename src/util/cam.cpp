@@ -0,0 +1,90 @@
+/*
+ * Andrew Smith
+ *
+ * CAM
+ *
+ */
+
+#include <cassert>
+
+#include "cam.h"
+
+Utility::Cam::Cam(uint64_t depth) {
+  assert(depth > 0);
+  _depth = depth;
+  _size = 0;
+  // At most half full keeps the probe sequences short
+  uint64_t entries = 2;
+  _shift = 63;
+  while(entries < 2 * depth) {
+    entries <<= 1;
+    _shift--;
+  }
+  _table.resize(entries, {0, false});
+}
+
+uint64_t Utility::Cam::slot(uint64_t key) const {
+  // Fibonacci hashing spreads consecutive vertex ids over the table
+  return (key * 0x9E3779B97F4A7C15ull) >> _shift;
+}
+
+uint64_t Utility::Cam::find(uint64_t key) const {
+  uint64_t mask = _table.size() - 1;
+  for(uint64_t i = slot(key); _table[i].valid; i = (i + 1) & mask) {
+    if(_table[i].key == key) {
+      return i;
+    }
+  }
+  return _table.size();
+}
+
+bool Utility::Cam::contains(uint64_t key) const {
+  return find(key) != _table.size();
+}
+
+bool Utility::Cam::insert(uint64_t key) {
+  assert(!contains(key));
+  if(full()) {
+    return false;
+  }
+  uint64_t mask = _table.size() - 1;
+  uint64_t i = slot(key);
+  while(_table[i].valid) {
+    i = (i + 1) & mask;
+  }
+  _table[i] = {key, true};
+  _size++;
+  return true;
+}
+
+void Utility::Cam::erase(uint64_t key) {
+  uint64_t i = find(key);
+  assert(i != _table.size());
+  // Shift later entries of the probe sequence back into the hole
+  uint64_t mask = _table.size() - 1;
+  for(uint64_t j = (i + 1) & mask; _table[j].valid; j = (j + 1) & mask) {
+    uint64_t home = slot(_table[j].key);
+    if(((j - home) & mask) >= ((j - i) & mask)) {
+      _table[i] = _table[j];
+      i = j;
+    }
+  }
+  _table[i].valid = false;
+  _size--;
+}
+
+uint64_t Utility::Cam::size(void) const {
+  return _size;
+}
+
+uint64_t Utility::Cam::depth(void) const {
+  return _depth;
+}
+
+bool Utility::Cam::full(void) const {
+  return _size >= _depth;
+}
+
+bool Utility::Cam::empty(void) const {
+  return _size == 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * Andrew Smith
+ *
+ * CAM:
+ *  Fixed size content addressable memory of 64-bit keys. Keys hash into a
+ *  table twice the depth with linear probing, so lookups, inserts and
+ *  erases take a few probes no matter how many keys are held.
+ *
+ */
+
+#ifndef CAM_H
+#define CAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Utility {
+
+class Cam {
+private:
+  struct entry_t {
+    uint64_t key;
+    bool valid;
+  };
+
+  std::vector<entry_t> _table;
+  uint64_t _shift; // Keeps the top bits of the hash
+  uint64_t _depth;
+  uint64_t _size;
+
+  uint64_t slot(uint64_t key) const;
+  // Table index holding key, _table.size() if absent
+  uint64_t find(uint64_t key) const;
+
+public:
+  Cam(uint64_t depth);
+
+  bool contains(uint64_t key) const;
+  // Returns false if the CAM is full, key must not be held already
+  bool insert(uint64_t key);
+  // key must be held
+  void erase(uint64_t key);
+
+  uint64_t size(void) const;
+  uint64_t depth(void) const;
+  bool full(void) const;
+  bool empty(void) const;
+}; // class Cam
+
+} // namespace Utility
+
+#endif
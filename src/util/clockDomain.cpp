@@ -0,0 +1,42 @@
+/*
+ * Andrew Smith
+ *
+ * Clock Domain
+ *
+ */
+
+#include <cassert>
+
+#include "clockDomain.h"
+
+Utility::ClockDomain::ClockDomain() {
+  _frequency = 1;
+  _reference = 1;
+  _accumulator = 0;
+  _ticks = 0;
+}
+
+Utility::ClockDomain::ClockDomain(uint64_t frequency, uint64_t reference) {
+  assert(frequency != 0);
+  assert(reference != 0);
+  _frequency = frequency;
+  _reference = reference;
+  _accumulator = 0;
+  _ticks = 0;
+}
+
+uint64_t Utility::ClockDomain::advance(void) {
+  _accumulator += _frequency;
+  uint64_t cycles = _accumulator / _reference;
+  _accumulator %= _reference;
+  _ticks += cycles;
+  return cycles;
+}
+
+uint64_t Utility::ClockDomain::get_ticks(void) const {
+  return _ticks;
+}
+
+uint64_t Utility::ClockDomain::get_frequency(void) const {
+  return _frequency;
+}
@@ -0,0 +1,38 @@
+/*
+ * Andrew Smith
+ *
+ * Clock Domain:
+ *  Converts reference (accelerator) cycles into cycles of another clock.
+ *  Every reference cycle adds the domain frequency to an accumulator and
+ *  the domain ticks once per whole reference period in it, so a 667 MHz
+ *  DRAM ticks two cycles out of every three of a 1 GHz pipeline.
+ *
+ */
+
+#ifndef CLOCK_DOMAIN_H
+#define CLOCK_DOMAIN_H
+
+#include <cstdint>
+
+namespace Utility {
+
+class ClockDomain {
+private:
+  uint64_t _frequency;   // Any unit, as long as both match
+  uint64_t _reference;
+  uint64_t _accumulator;
+  uint64_t _ticks;
+
+public:
+  ClockDomain(void);
+  ClockDomain(uint64_t frequency, uint64_t reference);
+
+  // Cycles of this domain in the next reference cycle
+  uint64_t advance(void);
+  uint64_t get_ticks(void) const;
+  uint64_t get_frequency(void) const;
+}; // class ClockDomain
+
+} // namespace Utility
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Andrew Smith
+ *
+ * Ini Reader
+ *
+ */
+
+#include <fstream>
+#include <stdexcept>
+
+#include "iniReader.h"
+
+namespace {
+
+std::string trim(const std::string& s) {
+  size_t first = s.find_first_not_of(" \t\r");
+  if(first == std::string::npos) {
+    return "";
+  }
+  size_t last = s.find_last_not_of(" \t\r");
+  return s.substr(first, last - first + 1);
+}
+
+} // namespace
+
+Utility::IniReader::IniReader() {
+  // Do Nothing
+}
+
+Utility::IniReader::IniReader(const std::string& path) {
+  read(path);
+}
+
+void Utility::IniReader::read(const std::string& path) {
+  std::ifstream file(path);
+  if(!file.is_open()) {
+    throw std::runtime_error("unable to open ini file: " + path);
+  }
+  std::string line;
+  while(std::getline(file, line)) {
+    line = line.substr(0, line.find(';'));
+    size_t equals = line.find('=');
+    if(equals == std::string::npos) {
+      continue;
+    }
+    std::string key = trim(line.substr(0, equals));
+    if(!key.empty()) {
+      _values[key] = trim(line.substr(equals + 1));
+    }
+  }
+}
+
+bool Utility::IniReader::has(const std::string& key) const {
+  return _values.count(key) != 0;
+}
+
+uint64_t Utility::IniReader::get_uint(const std::string& key, uint64_t value) const {
+  auto it = _values.find(key);
+  return it == _values.end() ? value : std::stoull(it->second);
+}
+
+double Utility::IniReader::get_double(const std::string& key, double value) const {
+  auto it = _values.find(key);
+  return it == _values.end() ? value : std::stod(it->second);
+}
+
+std::string Utility::IniReader::get_string(const std::string& key, const std::string& value) const {
+  auto it = _values.find(key);
+  return it == _values.end() ? value : it->second;
+}
@@ -0,0 +1,37 @@
+/*
+ * Andrew Smith
+ *
+ * Ini Reader:
+ *  Reads the KEY=value lines of a DRAMSim2 style .ini file. Anything after
+ *  a ';' is a comment, so the device and system files can be shared with
+ *  DRAMSim2 unchanged.
+ *
+ */
+
+#ifndef INI_READER_H
+#define INI_READER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Utility {
+
+class IniReader {
+private:
+  std::map<std::string, std::string> _values;
+
+public:
+  IniReader(void);
+  IniReader(const std::string& path);
+
+  void read(const std::string& path);
+  bool has(const std::string& key) const;
+  uint64_t get_uint(const std::string& key, uint64_t value) const;
+  double get_double(const std::string& key, double value) const;
+  std::string get_string(const std::string& key, const std::string& value) const;
+}; // class IniReader
+
+} // namespace Utility
+
+#endif
@@ -1,20 +1,26 @@
 #ifndef READGRAPH_H
 #define READGRAPH_H
 
+#include <algorithm>
+#include <cassert>
 #include <fstream>
 #include <queue>
+#include <vector>
 
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 
 #include "option.h"
+#include "addressMap.h"
 
 namespace Utility {
 
 template<class v_t>
 class readGraph {
   public:
-    readGraph(Options const & opt) : shouldInit(opt.shouldInit) {}
+    readGraph(Options const & opt) : shouldInit(opt.shouldInit), splitDegree(opt.split_degree),
+      sliceVertices(opt.scratchpad_capacity * opt.num_pipelines / sizeof(v_t)), activeSlice(0),
+      dramMap(opt.dram_row_size), scratchMap(opt.dram_row_size) {}
 
     void readMatrixMarket(const char *mmInputFile);
 
@@ -28,7 +34,18 @@ class readGraph {
     double getEdgeWeight(int neighborInd) { return edgeWeights[neighborInd]; }
 
     v_t getVertexProperty(int nodeInd) { return vertex_property[nodeInd]; }
-    uint64_t getVertexAddress(int nodeInd) { return (uint64_t)&vertex_property[nodeInd]; }
+    // Simulated addresses, see buildAddressMap
+    uint64_t getVertexAddress(int nodeInd) { return dramMap.get_address(REGION_VERTEX_PROPERTY, nodeInd); }
+    uint64_t getNodePtrAddress(int nodeInd) { return dramMap.get_address(REGION_NODE_PTRS, nodeInd); }
+    uint64_t getNeighborAddress(int neighborInd) { return dramMap.get_address(REGION_NEIGHBORS, neighborInd); }
+    uint64_t getEdgeWeightAddress(int neighborInd) { return dramMap.get_address(REGION_EDGE_WEIGHTS, neighborInd); }
+    uint64_t getTempVertexAddress(int nodeInd) { return scratchMap.get_address(REGION_TEMP_PROPERTY, nodeInd % tempVertices()); }
+    // Vertex whose property is at addr, -1 outside the vertex properties
+    int64_t getVertexAtAddress(uint64_t addr) {
+      uint64_t base = dramMap.get_base(REGION_VERTEX_PROPERTY);
+      if(addr < base || addr >= base + dramMap.get_size(REGION_VERTEX_PROPERTY)) return -1;
+      return (addr - base) / sizeof(v_t);
+    }
     void setVertexProperty(int nodeInd, v_t vertexProperty) { vertex_property[nodeInd] = vertexProperty; }
     void setInitializer(v_t initialValue) { initialVertexValue = initialValue; }
     v_t getInitializer() { return initialVertexValue; }
@@ -47,6 +64,45 @@ class readGraph {
       while (start != end) retval->push(start++);
       return retval;
     }
+    // Edges of the chunk starting at edge position start (see splitDegree)
+    std::queue<uint>* getEdges(int nodeInd, uint start) {
+      uint end = getChunkEnd(nodeInd, start);
+      std::queue<uint> *retval = new std::queue<uint>;
+      while (start != end) retval->push(getEdgeAt(start++));
+      return retval;
+    }
+
+    // Destination slicing: when the temp properties of all destinations do
+    // not fit in the scratchpads, destinations are split into ranges of
+    // sliceVertices and each slice gets its own edge lists. Edge positions
+    // index the active slice's edge list, or the edge arrays if not sliced.
+    int getNumSlices() { return sliceEdges.empty() ? 1 : sliceEdges.size(); }
+    void setSlice(int slice) { assert(slice < getNumSlices()); activeSlice = slice; }
+    uint getEdgeBegin(int nodeInd) {
+      if(sliceEdges.empty()) return getNodePtr(nodeInd);
+      return sliceSourcePtrs[activeSlice][sliceSourceIndex(nodeInd)];
+    }
+    uint getEdgeEnd(int nodeInd) {
+      if(sliceEdges.empty()) return getNodePtr(nodeInd+1);
+      uint ind = sliceSourceIndex(nodeInd);
+      bool hasEdges = ind < sliceSources[activeSlice].size() && sliceSources[activeSlice][ind] == (uint)nodeInd;
+      return sliceSourcePtrs[activeSlice][ind + hasEdges];
+    }
+    uint getEdgeAt(uint pos) { return sliceEdges.empty() ? pos : sliceEdges[activeSlice][pos]; }
+
+    // High-degree vertex splitting: a vertex with more than splitDegree edges
+    // is scheduled as ceil(degree / splitDegree) independent chunks
+    int getNumChunks(int nodeInd) {
+      uint degree = getEdgeEnd(nodeInd) - getEdgeBegin(nodeInd);
+      if(splitDegree == 0 || degree <= splitDegree) return 1;
+      return (degree + splitDegree - 1) / splitDegree;
+    }
+    uint getChunkStart(int nodeInd, int chunk) { return getEdgeBegin(nodeInd) + chunk * splitDegree; }
+    uint getChunkEnd(int nodeInd, uint start) {
+      uint end = getEdgeEnd(nodeInd);
+      if(splitDegree != 0 && start + splitDegree < end) return start + splitDegree;
+      return end;
+    }
     std::queue<uint>* getIncomingNeighbors(int nodeInd) {
       uint *startPtr = nodeIncomingNeighbors + getNodeIncomingPtr(nodeInd);
       uint *endPtr = nodeIncomingNeighbors + getNodeIncomingPtr(nodeInd+1);
@@ -81,6 +137,26 @@ class readGraph {
     v_t initialVertexValue;
 
     int shouldInit;
+    unsigned long long int splitDegree;
+
+    unsigned long long int sliceVertices; // 0: never slice
+    int activeSlice;
+    // Per slice, the sources with edges in it (ascending) and where their
+    // edges start in sliceEdges, with the list size appended
+    std::vector<std::vector<uint>> sliceSources;
+    std::vector<std::vector<uint>> sliceSourcePtrs;
+    std::vector<std::vector<uint>> sliceEdges;
+    uint64_t tempVertices() { return sliceEdges.empty() ? (uint64_t)*numNodes + 1 : sliceVertices; }
+    // First source of the active slice not below nodeInd
+    uint sliceSourceIndex(int nodeInd) {
+      const std::vector<uint>& sources = sliceSources[activeSlice];
+      return std::lower_bound(sources.begin(), sources.end(), (uint)nodeInd) - sources.begin();
+    }
+
+    // DRAM holds the CSR arrays and vertex properties, the scratchpad
+    // holds the temp properties
+    AddressMap dramMap;
+    AddressMap scratchMap;
 
     boost::interprocess::shared_memory_object graphData;
     boost::interprocess::mapped_region region;
@@ -89,6 +165,9 @@ class readGraph {
     void writeBin(std::string binFname);
 
     void allocateGraph();
+    void reportSplit();
+    void buildAddressMap();
+    void buildSlices();
 };
 
 }; // namespace Utility
@@ -161,6 +161,59 @@ void Utility::readGraph<v_t>::readMatrixMarket(const char *mmInputFile) {
     free(I);
     writeBin(binFname);
   }
+  reportSplit();
+  buildSlices();
+  buildAddressMap();
+}
+
+template<class v_t>
+void Utility::readGraph<v_t>::buildSlices() {
+  if(sliceVertices == 0 || (uint64_t)*numNodes + 1 <= sliceVertices) return;
+  int slices = (*numNodes + sliceVertices) / sliceVertices;
+  sliceSources.assign(slices, std::vector<uint>());
+  sliceSourcePtrs.assign(slices, std::vector<uint>());
+  sliceEdges.assign(slices, std::vector<uint>());
+  for(int nodeInd = 0; nodeInd <= *numNodes; nodeInd++) {
+    for(uint edge = getNodePtr(nodeInd); edge < (uint)getNodePtr(nodeInd+1); edge++) {
+      int slice = nodeNeighbors[edge] / sliceVertices;
+      if(sliceSources[slice].empty() || sliceSources[slice].back() != (uint)nodeInd) {
+        sliceSources[slice].push_back(nodeInd);
+        sliceSourcePtrs[slice].push_back(sliceEdges[slice].size());
+      }
+      sliceEdges[slice].push_back(edge);
+    }
+  }
+  for(int slice = 0; slice < slices; slice++) {
+    sliceSourcePtrs[slice].push_back(sliceEdges[slice].size());
+  }
+  fprintf(stderr, "[readMatrixMarket] slicing destinations into %d slices of %llu vertices\n", slices, sliceVertices);
+}
+
+template<class v_t>
+void Utility::readGraph<v_t>::buildAddressMap() {
+  dramMap.add_region(REGION_NODE_PTRS, *numNodes + 2, sizeof(unsigned int));
+  dramMap.add_region(REGION_NEIGHBORS, *numNeighbors, sizeof(unsigned int));
+  dramMap.add_region(REGION_EDGE_WEIGHTS, *numNeighbors, sizeof(double));
+  dramMap.add_region(REGION_VERTEX_PROPERTY, *numNodes + 1, sizeof(v_t));
+  scratchMap.add_region(REGION_TEMP_PROPERTY, tempVertices(), sizeof(v_t));
+  fprintf(stderr, "[readMatrixMarket] address map:\n");
+  dramMap.print(std::cerr);
+  scratchMap.print(std::cerr);
+}
+
+template<class v_t>
+void Utility::readGraph<v_t>::reportSplit() {
+  if(splitDegree == 0) return;
+  uint64_t splitNodes = 0;
+  uint64_t chunks = 0;
+  for(int nodeInd = 0; nodeInd <= *numNodes; nodeInd++) {
+    int nodeChunks = getNumChunks(nodeInd);
+    if(nodeChunks > 1) {
+      splitNodes++;
+      chunks += nodeChunks;
+    }
+  }
+  fprintf(stderr, "[readMatrixMarket] splitting %lu vertices with degree > %llu into %lu chunks\n", splitNodes, splitDegree, chunks);
 }
 
 template<class v_t>
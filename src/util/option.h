@@ -25,8 +25,12 @@ SOFTWARE.
 #define OPTION_H
 
 #include <iostream>
+#include <algorithm>
 #include <list>
+#include <map>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
@@ -37,24 +41,92 @@ namespace Utility {
   class Options {
     public:
       std::string logfile = "";
+      std::string trace = "";
       
       // Scratchpad options
       unsigned long long int scratchpad_read_latency = 1;
       unsigned long long int scratchpad_write_latency = 1;
       unsigned long long int scratchpad_num_simultaneous_requests = 4;
       unsigned long long int scratchpad_data_width = 4;
+      unsigned long long int scratchpad_capacity = 0; // bytes per pipeline, 0: unlimited
+      unsigned long long int scratchpad_clock = 0; // MHz, 0: pipeline_clock
+      unsigned long long int scratchpad_banks = 0; // 0: unbanked, scratch_num_requests slots
+      unsigned long long int scratchpad_ports = 1; // per bank
+      std::string scratchpad_hash = "mod";
       
       // Scratchpad options
       unsigned long long int dram_read_latency = 5;
       unsigned long long int dram_write_latency = 30;
       unsigned long long int dram_num_simultaneous_requests = 1000;
       unsigned long long int dram_data_width = 256;
+      unsigned long long int dram_bandwidth = 64; // bytes per cycle, 0: unlimited
+      std::string dram_model = "simple";
+      std::string dram_ini = "./modules/memory/DDR3_micron_64M_8B_x4_sg15.ini";
+      std::string dram_system_ini = "./modules/memory/graphicionado_system.ini";
+      unsigned long long int dram_megs = 65536;
+      unsigned long long int dram_clock = 0; // MHz, 0: tCK of dram_ini, or pipeline_clock for the simple model
+      unsigned long long int mem_channels = 1;
+      std::string channel_policy = "interleave";
+      unsigned long long int channel_interleave = 4096; // bytes
+      unsigned long long int remote_latency = 20;
+      unsigned long long int remote_bandwidth = 32; // bytes per cycle, 0: unlimited
+      unsigned long long int mem_slots = 1;
+      std::string mem_order = "in_order";
+      unsigned long long int dram_row_size = 16384; // bytes per row across the rank
+      unsigned long long int dram_banks = 8;
+      int coalesce = 0;
+      int edge_burst = 0;
+
+      // Vertex property cache options
+      unsigned long long int cache_capacity = 0; // bytes, 0: no cache
+      unsigned long long int cache_ways = 8;
+      unsigned long long int cache_line = 64;
+      std::string cache_replacement = "lru";
+      unsigned long long int cache_mshrs = 16;
+      std::string cache_write_policy = "back";
+      unsigned long long int cache_hit_latency = 1;
+
+      // Stream prefetcher options
+      unsigned long long int prefetch_depth = 0; // lines ahead, 0: no prefetcher
+      unsigned long long int prefetch_streams = 4;
+      unsigned long long int prefetch_line = 64;
+      unsigned long long int prefetch_hit_latency = 1;
+      unsigned long long int indirect_lookahead = 0; // edges, 0: no indirect prefetch
+      unsigned long long int indirect_entries = 16;
+
+      // Crossbar Options
+      unsigned long long int xbar_depth = 1;
+      unsigned long long int xbar_input_depth = 0; // 0: inputs write straight into the output queues
+      unsigned long long int xbar_latency = 0;
+      unsigned long long int xbar_input_bandwidth = 1;
+      unsigned long long int xbar_output_bandwidth = 1;
+      std::string xbar_arbitration = "rr";
+      int xbar_bypass = 0;
+
+      // Network Options
+      std::string interconnect = "crossbar";
+      unsigned long long int noc_width = 0; // 0: squarest grid
+      unsigned long long int noc_hop_latency = 1;
+      unsigned long long int noc_buffer_depth = 4;
 
       // Simultaion Options
       unsigned long long int num_iter = 10000;
       unsigned long long int num_pipelines = 1;
+      unsigned long long int pipeline_clock = 1000; // MHz
       unsigned long long int avg_connectivity = 1;
+      unsigned long long int frontier_capacity = 0; // 0: sized from the graph
+      int work_stealing = 0;
+      unsigned long long int steal_latency = 10;
+      unsigned long long int steal_batch = 16;
       int shouldInit = 0; // Used for the readGraph
+      unsigned long long int split_degree = 0; // 0: never split vertices
+      std::string frontier_order = "fifo";
+      unsigned long long int host_threads = 0; // 0: std::thread::hardware_concurrency
+      std::string fifo = ""; // stage=depth,... FIFO after each named stage
+      std::map<std::string, unsigned long long int> fifo_depth;
+      int decoupled = 0;
+      unsigned long long int decoupled_depth = 1024; // events per ring
+      unsigned long long int cau_depth = 0; // 0: one entry per edge the stages past the atomic unit can hold
       std::string graph_path = "";
       std::string result = "vertex_properties.out";
 
@@ -70,6 +142,7 @@ namespace Utility {
           po::options_description io("File IO options");
           io.add_options()
             ("logfile", po::value<std::string>(&logfile) ,"the name of the log file to write to")
+            ("trace", po::value<std::string>(&trace), "memory trace file, written by g_sim and read by replay")
           ;
 
           po::options_description scratch("Scratchpad Options");
@@ -77,7 +150,12 @@ namespace Utility {
             ("scratch_read_latency", po::value<unsigned long long int>(&scratchpad_read_latency), "scratchpad read latency in cycles")
             ("scratch_write_latency", po::value<unsigned long long int>(&scratchpad_write_latency), "scratchpad write latency in cycles")
             ("scratch_num_requests", po::value<unsigned long long int>(&scratchpad_num_simultaneous_requests), "number of simultaneous requests")
-            ("scratch_width", po::value<unsigned long long int>(&scratchpad_data_width), "scratchpad data width in bytes");
+            ("scratch_width", po::value<unsigned long long int>(&scratchpad_data_width), "scratchpad data width in bytes")
+            ("scratch_clock", po::value<unsigned long long int>(&scratchpad_clock), "scratchpad clock in MHz (0 = pipeline_clock)")
+            ("scratch_banks", po::value<unsigned long long int>(&scratchpad_banks), "scratchpad banks of scratch_width words (0 = unbanked, scratch_num_requests slots)")
+            ("scratch_ports", po::value<unsigned long long int>(&scratchpad_ports), "requests each scratchpad bank serves per cycle")
+            ("scratch_hash", po::value<std::string>(&scratchpad_hash), "scratchpad address to bank hash: mod or xor")
+            ("scratchpad_capacity", po::value<unsigned long long int>(&scratchpad_capacity), "temp property bytes per pipeline scratchpad, destinations are sliced to fit (0 = unlimited)");
           ;
 
           po::options_description dram("DRAM Options");
@@ -85,14 +163,82 @@ namespace Utility {
             ("dram_read_latency", po::value<unsigned long long int>(&dram_read_latency), "dram read latency in cycles")
             ("dram_write_latency", po::value<unsigned long long int>(&dram_write_latency), "dram write latency in cycles")
             ("dram_num_requests", po::value<unsigned long long int>(&dram_num_simultaneous_requests), "number of simultaneous requests")
-            ("dram_width", po::value<unsigned long long int>(&dram_data_width), "dram data width in bytes");
+            ("dram_width", po::value<unsigned long long int>(&dram_data_width), "dram data width in bytes")
+            ("mem_slots", po::value<unsigned long long int>(&mem_slots), "reads each DRAM facing Read stage keeps in flight")
+            ("mem_order", po::value<std::string>(&mem_order), "order items leave a Read stage: in_order or out_of_order (as reads complete)")
+            ("dram_bandwidth", po::value<unsigned long long int>(&dram_bandwidth), "dram bytes per cycle of the simple model, 0 for unlimited")
+            ("dram_model", po::value<std::string>(&dram_model), "dram timing model: simple (latency and bandwidth), banked (native bank/row timing) or dramsim2 (needs a DRAMSIM2 build)")
+            ("dram_ini", po::value<std::string>(&dram_ini), "dram device .ini used by the banked and dramsim2 models")
+            ("dram_system_ini", po::value<std::string>(&dram_system_ini), "dram system .ini used by the banked and dramsim2 models")
+            ("dram_megs", po::value<unsigned long long int>(&dram_megs), "dram capacity in MB used by the banked and dramsim2 models")
+            ("dram_clock", po::value<unsigned long long int>(&dram_clock), "dram clock in MHz (0 = 1/tCK of dram_ini for the banked and dramsim2 models, pipeline_clock for simple)")
+            ("mem_channels", po::value<unsigned long long int>(&mem_channels), "independent memory instances, pipeline p is local to channel p % mem_channels")
+            ("channel_policy", po::value<std::string>(&channel_policy), "address to channel mapping: interleave, or owner (vertex properties in their owning pipeline's channel)")
+            ("channel_interleave", po::value<unsigned long long int>(&channel_interleave), "bytes per channel before interleaving to the next")
+            ("remote_latency", po::value<unsigned long long int>(&remote_latency), "extra cycles for a pipeline to reach a remote channel")
+            ("remote_bandwidth", po::value<unsigned long long int>(&remote_bandwidth), "bytes per cycle of each pipeline's remote link, 0 for unlimited")
+            ("dram_row_size", po::value<unsigned long long int>(&dram_row_size), "dram row size in bytes, used for row-buffer locality")
+            ("dram_banks", po::value<unsigned long long int>(&dram_banks), "number of dram banks rows are interleaved across")
+            ("coalesce", po::value<int>(&coalesce), "merge in-flight requests to the same dram_width line across all pipelines")
+            ("edge_burst", po::value<int>(&edge_burst), "stream edge lists from dram in dram_width bursts instead of one scratchpad read per edge");
+          ;
+
+          po::options_description cache("Cache Options");
+          cache.add_options()
+            ("cache_capacity", po::value<unsigned long long int>(&cache_capacity), "per-pipeline vertex property cache size in bytes, serves the destination reads and the Apply writes (0 = no cache)")
+            ("cache_ways", po::value<unsigned long long int>(&cache_ways), "cache associativity")
+            ("cache_line", po::value<unsigned long long int>(&cache_line), "cache line size in bytes")
+            ("cache_replacement", po::value<std::string>(&cache_replacement), "cache replacement policy: lru, fifo or random")
+            ("cache_mshrs", po::value<unsigned long long int>(&cache_mshrs), "outstanding cache line fills")
+            ("cache_write_policy", po::value<std::string>(&cache_write_policy), "cache write policy: back or through")
+            ("cache_hit_latency", po::value<unsigned long long int>(&cache_hit_latency), "cache hit latency in cycles");
+          ;
+
+          po::options_description prefetch("Prefetcher Options");
+          prefetch.add_options()
+            ("prefetch_depth", po::value<unsigned long long int>(&prefetch_depth), "lines fetched ahead of each sequential stream (0 = no prefetcher)")
+            ("prefetch_streams", po::value<unsigned long long int>(&prefetch_streams), "streams tracked per pipeline")
+            ("prefetch_line", po::value<unsigned long long int>(&prefetch_line), "prefetch granularity in bytes")
+            ("prefetch_hit_latency", po::value<unsigned long long int>(&prefetch_hit_latency), "latency of a read served from a stream buffer")
+            ("indirect_lookahead", po::value<unsigned long long int>(&indirect_lookahead), "edges ahead of ReadSrcEdges to prefetch destination properties for (0 = off)")
+            ("indirect_entries", po::value<unsigned long long int>(&indirect_entries), "destination properties buffered per port by the indirect prefetcher");
           ;
 
           po::options_description sim("Simulation Options");
           sim.add_options()
             ("num_iter", po::value<unsigned long long int>(&num_iter), "the number of iterations to simulate")
             ("num_pipelines", po::value<unsigned long long int>(&num_pipelines), "the number of pipelines in parallel")
-            ("avg_connectivity", po::value<unsigned long long int>(&avg_connectivity), "the average connectivity k of the graph");
+            ("pipeline_clock", po::value<unsigned long long int>(&pipeline_clock), "pipeline clock in MHz, memories clocked differently tick at their own rate")
+            ("avg_connectivity", po::value<unsigned long long int>(&avg_connectivity), "the average connectivity k of the graph")
+            ("frontier_capacity", po::value<unsigned long long int>(&frontier_capacity), "entries in the global frontier queue (0 = vertices + edges)")
+            ("work_stealing", po::value<int>(&work_stealing), "per-pipeline frontier queues, idle pipelines steal from busy ones")
+            ("steal_latency", po::value<unsigned long long int>(&steal_latency), "cycles for a pipeline to steal a batch of vertices")
+            ("steal_batch", po::value<unsigned long long int>(&steal_batch), "max vertices moved by one steal")
+            ("frontier_order", po::value<std::string>(&frontier_order), "order of the frontier each iteration: fifo, vertex (sorted by id) or row (grouped by dram row)")
+            ("host_threads", po::value<unsigned long long int>(&host_threads), "host threads used to sort the frontier (0 = all cores)")
+            ("fifo", po::value<std::string>(&fifo), "FIFO depths after pipeline stages, comma separated stage=depth (e.g. ReadDstProperty=4,Reduce=2), all=depth for every stage")
+            ("decoupled", po::value<int>(&decoupled), "functional engine threads stream source vertices, edges and updates to the timing pipelines")
+            ("decoupled_depth", po::value<unsigned long long int>(&decoupled_depth), "events buffered per functional stream ring")
+            ("cau_depth", po::value<unsigned long long int>(&cau_depth), "destinations the atomic update CAM tracks, edges in flight past it (0 = enough for every stage and FIFO up to WriteTempDstProperty)");
+          ;
+
+          po::options_description xbar("Crossbar Options");
+          xbar.add_options()
+            ("xbar_depth", po::value<unsigned long long int>(&xbar_depth), "items queued per crossbar output, items crossing the switch occupy it for xbar_latency cycles")
+            ("xbar_input_depth", po::value<unsigned long long int>(&xbar_input_depth), "items queued per crossbar input (0 = no input queues, first come first served)")
+            ("xbar_latency", po::value<unsigned long long int>(&xbar_latency), "cycles to cross the crossbar")
+            ("xbar_input_bandwidth", po::value<unsigned long long int>(&xbar_input_bandwidth), "items each input sends through the crossbar per cycle")
+            ("xbar_output_bandwidth", po::value<unsigned long long int>(&xbar_output_bandwidth), "items each output queue receives through the crossbar per cycle, a queue still delivers one item per cycle to its stage")
+            ("xbar_arbitration", po::value<std::string>(&xbar_arbitration), "crossbar arbitration between input queues: rr (round-robin) or age (oldest first)")
+            ("xbar_bypass", po::value<int>(&xbar_bypass), "items staying in their own pipeline skip the crossbar latency and bandwidth limits")
+          ;
+
+          po::options_description noc("Network Options");
+          noc.add_options()
+            ("interconnect", po::value<std::string>(&interconnect), "interconnect between the pipelines: crossbar, or a mesh, torus or ring network with XY routing")
+            ("noc_width", po::value<unsigned long long int>(&noc_width), "routers per row of the mesh or torus, must divide num_pipelines (0 = squarest grid)")
+            ("noc_hop_latency", po::value<unsigned long long int>(&noc_hop_latency), "cycles for a packet to cross one router and link")
+            ("noc_buffer_depth", po::value<unsigned long long int>(&noc_buffer_depth), "packets buffered per router input port, torus and ring need at least 2")
           ;
 
           po::options_description graph("ReadGrpah Options");
@@ -100,6 +246,7 @@ namespace Utility {
             ("should_init", po::value<int>(&shouldInit), "graph needs to be initialized")
             ("graph_path", po::value<std::string>(&graph_path), "path to mat market format graph")
             ("vertex_properties", po::value<std::string>(&result), "name for the output file containing vertex values for verification")
+            ("split_degree", po::value<unsigned long long int>(&split_degree), "split vertices with more edges than this into independently scheduled chunks (0 = off)")
           ;
 
 
@@ -108,6 +255,10 @@ namespace Utility {
           all_options.add(io);
           all_options.add(scratch);
           all_options.add(dram);
+          all_options.add(cache);
+          all_options.add(prefetch);
+          all_options.add(xbar);
+          all_options.add(noc);
           all_options.add(sim);
           all_options.add(graph);
 
@@ -116,8 +267,87 @@ namespace Utility {
           po::store(po::parse_command_line(argc, argv, all_options), vm);
           po::notify(vm);
 
+          if(frontier_order != "fifo" && frontier_order != "vertex" && frontier_order != "row") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "frontier_order", frontier_order);
+          }
+#ifdef DRAMSIM2
+          if(dram_model != "simple" && dram_model != "banked" && dram_model != "dramsim2") {
+#else
+          if(dram_model != "simple" && dram_model != "banked") {
+#endif
+            throw po::validation_error(po::validation_error::invalid_option_value, "dram_model", dram_model);
+          }
+          if(channel_policy != "interleave" && channel_policy != "owner") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "channel_policy", channel_policy);
+          }
+          if(scratchpad_hash != "mod" && scratchpad_hash != "xor") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "scratch_hash", scratchpad_hash);
+          }
+          if(cache_replacement != "lru" && cache_replacement != "fifo" && cache_replacement != "random") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "cache_replacement", cache_replacement);
+          }
+          if(cache_write_policy != "back" && cache_write_policy != "through") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "cache_write_policy", cache_write_policy);
+          }
+          // Stages followed by another stage in the same pipeline
+          const std::vector<std::string> fifo_stages = {"all", "ReadSrcProperty", "ReadDstProperty", "ProcessEdge", "ControlAtomicUpdate",
+                                                        "ReadTempDstProperty", "Reduce", "ReadVertexProperty", "ReadTempVertexProperty", "Apply"};
+          std::stringstream fifo_list(fifo);
+          std::string entry;
+          while(std::getline(fifo_list, entry, ',')) {
+            size_t split = entry.find('=');
+            if(split == std::string::npos || std::find(fifo_stages.begin(), fifo_stages.end(), entry.substr(0, split)) == fifo_stages.end()) {
+              throw po::validation_error(po::validation_error::invalid_option_value, "fifo", entry);
+            }
+            try {
+              fifo_depth[entry.substr(0, split)] = std::stoull(entry.substr(split + 1));
+            }
+            catch(const std::exception&) {
+              throw po::validation_error(po::validation_error::invalid_option_value, "fifo", entry);
+            }
+          }
+          if(xbar_depth == 0 || xbar_input_bandwidth == 0 || xbar_output_bandwidth == 0) {
+            throw po::error("xbar_depth, xbar_input_bandwidth and xbar_output_bandwidth must be at least 1");
+          }
+          if(xbar_arbitration != "rr" && xbar_arbitration != "age") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "xbar_arbitration", xbar_arbitration);
+          }
+          if(interconnect != "crossbar" && interconnect != "mesh" && interconnect != "torus" && interconnect != "ring") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "interconnect", interconnect);
+          }
+          if(noc_width != 0 && num_pipelines % noc_width != 0) {
+            throw po::validation_error(po::validation_error::invalid_option_value, "noc_width", std::to_string(noc_width));
+          }
+          if(noc_hop_latency == 0) {
+            throw po::validation_error(po::validation_error::invalid_option_value, "noc_hop_latency", std::to_string(noc_hop_latency));
+          }
+          if(noc_buffer_depth < (interconnect == "torus" || interconnect == "ring" ? 2u : 1u)) {
+            // Bubble flow control keeps a slot free in each ring
+            throw po::validation_error(po::validation_error::invalid_option_value, "noc_buffer_depth", std::to_string(noc_buffer_depth));
+          }
+          if(mem_slots == 0) {
+            throw po::validation_error(po::validation_error::invalid_option_value, "mem_slots", std::to_string(mem_slots));
+          }
+          if(mem_order != "in_order" && mem_order != "out_of_order") {
+            throw po::validation_error(po::validation_error::invalid_option_value, "mem_order", mem_order);
+          }
+          if(decoupled && (work_stealing || split_degree)) {
+            // The functional engine assigns whole vertices up front
+            throw po::error("decoupled cannot be combined with work_stealing or split_degree");
+          }
+
           return true;
       }
+
+      // FIFO depth after stage, 0 if it hands items straight to the next stage
+      unsigned long long int get_fifo_depth(const std::string& stage) const
+      {
+          auto it = fifo_depth.find(stage);
+          if(it == fifo_depth.end()) {
+            it = fifo_depth.find("all");
+          }
+          return (it == fifo_depth.end()) ? 0 : it->second;
+      }
   }; //End of class Options
 }; //End of namespace Utility
 #endif
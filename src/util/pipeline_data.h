@@ -10,11 +10,16 @@
 #define PIPELINE_DATA_H
 
 #include <iostream>
+#include <cstdint>
 
 namespace Utility {
 
 // v_t is the data type of the vertex
 // e_t is the data type of the edge
+// Fields are ordered from widest to narrowest so the token packs without
+// interior padding; for the default <bool, double> instantiation the whole
+// struct fits in a single 64B cache line. Hand-offs between modules pass it
+// by const reference, each stage keeps its own copy in Module::_data.
 template<class v_t, class e_t>
 struct pipeline_data {
   uint64_t vertex_id;
@@ -23,14 +28,14 @@ struct pipeline_data {
   uint64_t vertex_dst_id_addr;
   uint64_t edge_id;
 
+  e_t edge_data;
+  e_t edge_temp_data;
+
   v_t vertex_data;
   v_t vertex_dst_data;
   v_t message_data;
   v_t vertex_temp_dst_data;
 
-  e_t edge_data;
-  e_t edge_temp_data;
-
   bool last_vertex;
   bool last_edge;
 
@@ -38,17 +43,19 @@ struct pipeline_data {
 
   pipeline_data() {
     vertex_id = 0;
+    vertex_id_addr = 0;
     vertex_dst_id = 0;
+    vertex_dst_id_addr = 0;
     edge_id = 0;
 
+    edge_data = e_t();
+    edge_temp_data = e_t();
+
     vertex_data = v_t();
     vertex_dst_data = v_t();
     message_data = v_t();
     vertex_temp_dst_data = v_t();
 
-    edge_data = e_t();
-    edge_temp_data = e_t();
-
     last_vertex = false;
     last_edge = false;
 
@@ -0,0 +1,28 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Parallel radix sort
+ *  Stable LSD radix sort, 8 bits per pass. The histogram and scatter of
+ *  every pass are split across host threads by contiguous blocks; offsets
+ *  are laid out digit-major, thread-minor so the sort stays stable.
+ *
+ */
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Utility {
+
+// Sort data by key(element), key must return an unsigned 64-bit value
+template<class T, class key_f>
+void radixSort(std::vector<T>& data, key_f key, uint64_t num_threads);
+
+}; // namespace Utility
+
+#include "radixSort.tcc"
+
+#endif // RADIX_SORT_H
@@ -0,0 +1,66 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Parallel radix sort
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+template<class T, class key_f>
+void Utility::radixSort(std::vector<T>& data, key_f key, uint64_t num_threads) {
+  const uint64_t n = data.size();
+  if(n < 2) {
+    return;
+  }
+  // Not worth a thread for less than a few thousand elements
+  num_threads = std::max<uint64_t>(1, std::min<uint64_t>(num_threads, n / 4096));
+  const uint64_t block = (n + num_threads - 1) / num_threads;
+
+  auto parallel = [num_threads](auto body) {
+    std::vector<std::thread> workers;
+    for(uint64_t t = 1; t < num_threads; t++) {
+      workers.emplace_back(body, t);
+    }
+    body(0);
+    for(auto & worker : workers) {
+      worker.join();
+    }
+  };
+
+  uint64_t max_key = 0;
+  for(auto & element : data) {
+    max_key = std::max<uint64_t>(max_key, key(element));
+  }
+
+  std::vector<T> buffer(n);
+  std::vector<std::array<uint64_t, 256>> counts(num_threads);
+  for(uint64_t shift = 0; shift < 64 && (max_key >> shift) != 0; shift += 8) {
+    // Per-thread digit histograms
+    parallel([&](uint64_t t) {
+      counts[t].fill(0);
+      for(uint64_t i = t * block; i < std::min(n, (t + 1) * block); i++) {
+        counts[t][(key(data[i]) >> shift) & 0xff]++;
+      }
+    });
+    // Exclusive prefix sum, digit-major then thread
+    uint64_t offset = 0;
+    for(uint64_t digit = 0; digit < 256; digit++) {
+      for(uint64_t t = 0; t < num_threads; t++) {
+        uint64_t count = counts[t][digit];
+        counts[t][digit] = offset;
+        offset += count;
+      }
+    }
+    // Scatter
+    parallel([&](uint64_t t) {
+      for(uint64_t i = t * block; i < std::min(n, (t + 1) * block); i++) {
+        buffer[counts[t][(key(data[i]) >> shift) & 0xff]++] = data[i];
+      }
+    });
+    data.swap(buffer);
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Fixed capacity ring buffer used for the queues between modules.
+ *  Storage is allocated once at construction, so nothing is allocated while
+ *  simulating. Single-producer/single-consumer lock-free: one thread may
+ *  push while another pops without any locking.
+ *
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace Utility {
+
+template<class T>
+class RingBuffer {
+private:
+  // Producer and consumer indices live on their own cache lines so the two
+  // sides do not false-share when pipelines are ticked on different threads
+  alignas(64) std::atomic<uint64_t> _head;
+  alignas(64) std::atomic<uint64_t> _tail;
+
+  alignas(64) uint64_t _capacity;
+  uint64_t _mask;
+  T* _buffer;
+
+public:
+  // Constructor
+  RingBuffer(uint64_t capacity);
+
+  // Destructor
+  ~RingBuffer();
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  // Push to the tail, returns false if the buffer is full (producer side)
+  bool push(const T& obj);
+
+  // Oldest element (consumer side)
+  T& front();
+
+  // Drop the oldest element (consumer side)
+  void pop();
+
+  // Pop the oldest element into obj, returns false if empty (consumer side)
+  bool pop(T& obj);
+
+  // i-th oldest element, 0 is the front
+  T& at(uint64_t i);
+
+  // Size
+  uint64_t size() const;
+  uint64_t capacity() const;
+
+  bool empty() const;
+  bool full() const;
+
+}; // class RingBuffer
+
+}; // namespace Utility
+
+#include "ringBuffer.tcc"
+
+#endif // RING_BUFFER_H
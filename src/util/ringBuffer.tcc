@@ -0,0 +1,91 @@
+/*
+ *
+ * Andrew Smith
+ *
+ * Fixed capacity ring buffer used for the queues between modules.
+ *
+ */
+
+#include <cassert>
+#include <cstddef>
+
+template<class T>
+Utility::RingBuffer<T>::RingBuffer(uint64_t capacity) {
+  assert(capacity > 0);
+  _capacity = capacity;
+  // Round the storage up to a power of two so indexing is a mask
+  uint64_t storage = 1;
+  while(storage < capacity) {
+    storage <<= 1;
+  }
+  _mask = storage - 1;
+  _buffer = new T[storage];
+  _head.store(0, std::memory_order_relaxed);
+  _tail.store(0, std::memory_order_relaxed);
+}
+
+template<class T>
+Utility::RingBuffer<T>::~RingBuffer() {
+  delete[] _buffer;
+  _buffer = NULL;
+}
+
+template<class T>
+bool Utility::RingBuffer<T>::push(const T& obj) {
+  uint64_t tail = _tail.load(std::memory_order_relaxed);
+  if(tail - _head.load(std::memory_order_acquire) >= _capacity) {
+    return false;
+  }
+  _buffer[tail & _mask] = obj;
+  _tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template<class T>
+T& Utility::RingBuffer<T>::front() {
+  assert(!empty());
+  return _buffer[_head.load(std::memory_order_relaxed) & _mask];
+}
+
+template<class T>
+void Utility::RingBuffer<T>::pop() {
+  assert(!empty());
+  _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template<class T>
+bool Utility::RingBuffer<T>::pop(T& obj) {
+  uint64_t head = _head.load(std::memory_order_relaxed);
+  if(head == _tail.load(std::memory_order_acquire)) {
+    return false;
+  }
+  obj = _buffer[head & _mask];
+  _head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template<class T>
+T& Utility::RingBuffer<T>::at(uint64_t i) {
+  assert(i < size());
+  return _buffer[(_head.load(std::memory_order_relaxed) + i) & _mask];
+}
+
+template<class T>
+uint64_t Utility::RingBuffer<T>::size() const {
+  return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+}
+
+template<class T>
+uint64_t Utility::RingBuffer<T>::capacity() const {
+  return _capacity;
+}
+
+template<class T>
+bool Utility::RingBuffer<T>::empty() const {
+  return size() == 0;
+}
+
+template<class T>
+bool Utility::RingBuffer<T>::full() const {
+  return size() >= _capacity;
+}
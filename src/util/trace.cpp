@@ -0,0 +1,167 @@
+/*
+ * Andrew Smith
+ *
+ * Memory Trace
+ *
+ */
+
+#include <cassert>
+#include <stdexcept>
+
+#include "trace.h"
+
+namespace {
+
+const char magic[] = "GSTRACE1";
+const uint64_t magic_size = sizeof(magic) - 1;
+
+enum trace_tag_t {
+  TAG_SOURCE = 0,
+  TAG_READ = 1,
+  TAG_WRITE = 2,
+  TAG_SEQUENTIAL = 4,
+  TAG_CHANNELS = 8
+};
+
+} // namespace
+
+Utility::TraceWriter::TraceWriter(const std::string& path) {
+  _file.open(path, std::ofstream::out | std::ofstream::binary);
+  if(!_file.is_open()) {
+    throw std::runtime_error("unable to open trace file: " + path);
+  }
+  _file.write(magic, magic_size);
+  _tick = 0;
+  _last_tick = 0;
+  _records = 0;
+}
+
+Utility::TraceWriter::~TraceWriter() {
+  _file.close();
+}
+
+void Utility::TraceWriter::put_varint(uint64_t value) {
+  while(value >= 0x80) {
+    _file.put((char)(value | 0x80));
+    value >>= 7;
+  }
+  _file.put((char)value);
+}
+
+uint64_t Utility::TraceWriter::add_source(const std::string& name) {
+  uint64_t source = _last_addr.size();
+  _last_addr.push_back(0);
+  _file.put((char)TAG_SOURCE);
+  put_varint(source);
+  put_varint(name.size());
+  _file.write(name.data(), name.size());
+  return source;
+}
+
+void Utility::TraceWriter::set_channels(uint64_t channels) {
+  _file.put((char)TAG_CHANNELS);
+  put_varint(channels);
+}
+
+void Utility::TraceWriter::tick(void) {
+  _tick++;
+}
+
+void Utility::TraceWriter::record(uint64_t source, bool write, bool sequential, uint64_t addr) {
+  assert(source < _last_addr.size());
+  _file.put((char)((write ? TAG_WRITE : TAG_READ) | (sequential ? TAG_SEQUENTIAL : 0)));
+  put_varint(source);
+  put_varint(_tick - _last_tick);
+  int64_t delta = (int64_t)(addr - _last_addr[source]);
+  put_varint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+  _last_tick = _tick;
+  _last_addr[source] = addr;
+  _records++;
+}
+
+uint64_t Utility::TraceWriter::get_records(void) const {
+  return _records;
+}
+
+Utility::TraceReader::TraceReader(const std::string& path) {
+  _file.open(path, std::ifstream::in | std::ifstream::binary);
+  if(!_file.is_open()) {
+    throw std::runtime_error("unable to open trace file: " + path);
+  }
+  char header[magic_size];
+  if(!_file.read(header, magic_size) || std::string(header, magic_size) != magic) {
+    throw std::runtime_error("not a memory trace: " + path);
+  }
+  _tick = 0;
+  _channels = 1;
+}
+
+Utility::TraceReader::~TraceReader() {
+  _file.close();
+}
+
+bool Utility::TraceReader::get_varint(uint64_t& value) {
+  value = 0;
+  for(int shift = 0; shift < 64; shift += 7) {
+    int byte = _file.get();
+    if(byte == EOF) {
+      return false;
+    }
+    value |= (uint64_t)(byte & 0x7f) << shift;
+    if((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Utility::TraceReader::next(trace_record_t& record) {
+  int tag;
+  while((tag = _file.get()) != EOF) {
+    if(tag == TAG_SOURCE) {
+      uint64_t source, size;
+      if(!get_varint(source) || !get_varint(size)) {
+        break;
+      }
+      std::string name(size, '\0');
+      _file.read(&name[0], size);
+      assert(source == _sources.size());
+      _sources.push_back(name);
+      _last_addr.push_back(0);
+      continue;
+    }
+    if(tag == TAG_CHANNELS) {
+      if(!get_varint(_channels)) {
+        break;
+      }
+      continue;
+    }
+    uint64_t source, tick, zigzag;
+    if(!get_varint(source) || !get_varint(tick) || !get_varint(zigzag) || source >= _sources.size()) {
+      break;
+    }
+    int64_t delta = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+    _tick += tick;
+    _last_addr[source] += delta;
+    record.tick = _tick;
+    record.source = source;
+    record.write = (tag & TAG_WRITE) != 0;
+    record.sequential = (tag & TAG_SEQUENTIAL) != 0;
+    record.addr = _last_addr[source];
+    return true;
+  }
+  return false;
+}
+
+const std::string& Utility::TraceReader::get_source(uint64_t source) const {
+  assert(source < _sources.size());
+  return _sources[source];
+}
+
+uint64_t Utility::TraceReader::get_num_sources(void) const {
+  return _sources.size();
+}
+
+uint64_t Utility::TraceReader::get_channels(void) const {
+  return _channels;
+}
@@ -0,0 +1,85 @@
+/*
+ * Andrew Smith
+ *
+ * Memory Trace:
+ *  Compact binary trace of memory requests. After the "GSTRACE1" magic
+ *  each record is a tag byte followed by varints:
+ *    source definition: tag 0, id, name length, name bytes
+ *    request:           tag 1 (read) or 2 (write), | 4 if sequential,
+ *                       source, tick delta, zigzag address delta
+ *    memory channels:   tag 8, channels (1 if absent)
+ *  Tick deltas are against the previous request and address deltas against
+ *  the previous request of the same source, so streaming sources take a few
+ *  bytes per request.
+ *
+ *  Sources are the pipeline stages and the indirect prefetcher, and a
+ *  request is what a source issued to its memory port. Requests the cache,
+ *  prefetchers, coalescer or memory channels make below that are not in
+ *  the trace, replay regenerates them.
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Utility {
+
+struct trace_record_t {
+  uint64_t tick;
+  uint64_t source;
+  bool write;
+  bool sequential;
+  uint64_t addr;
+};
+
+class TraceWriter {
+private:
+  std::ofstream _file;
+  uint64_t _tick;
+  uint64_t _last_tick;
+  std::vector<uint64_t> _last_addr;
+  uint64_t _records;
+
+  void put_varint(uint64_t value);
+
+public:
+  TraceWriter(const std::string& path);
+  ~TraceWriter();
+
+  uint64_t add_source(const std::string& name);
+  void set_channels(uint64_t channels);
+  void tick(void);
+  void record(uint64_t source, bool write, bool sequential, uint64_t addr);
+  uint64_t get_records(void) const;
+}; // class TraceWriter
+
+class TraceReader {
+private:
+  std::ifstream _file;
+  uint64_t _tick;
+  std::vector<uint64_t> _last_addr;
+  std::vector<std::string> _sources;
+  uint64_t _channels;
+
+  bool get_varint(uint64_t& value);
+
+public:
+  TraceReader(const std::string& path);
+  ~TraceReader();
+
+  // Next request, false at the end of the trace
+  bool next(trace_record_t& record);
+  const std::string& get_source(uint64_t source) const;
+  uint64_t get_num_sources(void) const;
+  // Memory channels of the traced run, known once next has been called
+  uint64_t get_channels(void) const;
+}; // class TraceReader
+
+} // namespace Utility
+
+#endif